@@ -0,0 +1,205 @@
+#include "StdInc.h"
+#include "AIProfiler.h"
+
+#include "../../lib/JsonNode.h"
+#include "../../lib/VCMIDirs.h"
+#include "../../lib/logging/CLogger.h"
+
+/*
+ * AIProfiler.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+static void keepProfiler(AIProfiler *)
+{
+	//profiler is owned by VCAI, thread only points to it while making turn
+}
+
+static boost::thread_specific_ptr<AIProfiler> recordingProfiler(&keepProfiler);
+
+AIProfiler::Scope::Scope(AIProfiler & owner, const char * name) : profiler(nullptr), event(0)
+{
+	if(owner.enabled && owner.isRecording())
+	{
+		profiler = &owner;
+		event = owner.openEvent(name);
+	}
+}
+
+AIProfiler::Scope::~Scope()
+{
+	if(profiler)
+		profiler->closeEvent(event);
+}
+
+void AIProfiler::Scope::setDetail(const std::string & detail)
+{
+	if(profiler)
+		profiler->events[event].detail = detail;
+}
+
+AIProfiler::AIProfiler() : enabled(false), day(0)
+{
+}
+
+void AIProfiler::setEnabled(bool on)
+{
+	enabled = on;
+}
+
+void AIProfiler::beginTurn(const std::string & player, int day)
+{
+	if(!enabled)
+		return;
+
+	this->player = player;
+	this->day = day;
+	events.clear();
+	openEvents.clear();
+	turnStart = boost::posix_time::microsec_clock::universal_time();
+	recordingProfiler.reset(this);
+}
+
+void AIProfiler::endTurn()
+{
+	if(!isRecording())
+		return;
+
+	while(!openEvents.empty()) //turn interrupted by exception
+		closeEvent(openEvents.back());
+	recordingProfiler.release();
+
+	writeTrace();
+	logSummary();
+}
+
+bool AIProfiler::isRecording() const
+{
+	return recordingProfiler.get() == this;
+}
+
+si64 AIProfiler::now() const
+{
+	return (boost::posix_time::microsec_clock::universal_time() - turnStart).total_microseconds();
+}
+
+size_t AIProfiler::openEvent(const char * name)
+{
+	Event e;
+	e.name = name;
+	e.start = now();
+	e.duration = -1;
+	e.childrenDuration = 0;
+	events.push_back(e);
+	openEvents.push_back(events.size() - 1);
+	return events.size() - 1;
+}
+
+void AIProfiler::closeEvent(size_t index)
+{
+	//scopes are nested, so closed event is always the innermost one
+	while(!openEvents.empty())
+	{
+		size_t last = openEvents.back();
+		openEvents.pop_back();
+
+		Event & e = events[last];
+		e.duration = now() - e.start;
+		if(!openEvents.empty())
+			events[openEvents.back()].childrenDuration += e.duration;
+
+		if(last == index)
+			break;
+	}
+}
+
+void AIProfiler::writeTrace() const
+{
+	JsonNode trace(JsonNode::DATA_STRUCT);
+	trace["displayTimeUnit"].String() = "ms";
+	JsonVector & entries = trace["traceEvents"].Vector();
+	entries.reserve(events.size());
+
+	for(const Event & e : events)
+	{
+		JsonNode entry(JsonNode::DATA_STRUCT);
+		entry["name"].String() = e.name;
+		entry["cat"].String() = "ai";
+		entry["ph"].String() = "X";
+		entry["ts"].Float() = e.start;
+		entry["dur"].Float() = e.duration;
+		entry["pid"].Float() = 0;
+		entry["tid"].Float() = 0;
+		if(!e.detail.empty())
+			entry["args"]["detail"].String() = e.detail;
+		entries.push_back(entry);
+	}
+
+	auto directory = VCMIDirs::get().userCachePath() / "aiProfile";
+	auto path = directory / boost::str(boost::format("%s_day%03d.json") % player % day);
+	try
+	{
+		boost::filesystem::create_directories(directory);
+		boost::filesystem::ofstream file(path, boost::filesystem::ofstream::trunc);
+		file << trace;
+	}
+	catch(std::exception & e)
+	{
+		logAi->error("Failed to write AI profile %s: %s", path.string(), e.what());
+	}
+}
+
+void AIProfiler::logSummary() const
+{
+	struct Total
+	{
+		int count;
+		si64 inclusive, exclusive;
+		Total() : count(0), inclusive(0), exclusive(0) {}
+	};
+
+	std::map<std::string, Total> totals;
+	si64 turnDuration = 0;
+	for(const Event & e : events)
+	{
+		Total & t = totals[e.name];
+		t.count++;
+		t.exclusive += e.duration - e.childrenDuration;
+		turnDuration = std::max(turnDuration, e.start + e.duration);
+	}
+
+	//inclusive time of recursive scopes (nested goal decomposition) is counted once per outermost instance
+	std::vector<size_t> stack;
+	for(const Event & e : events)
+	{
+		while(!stack.empty() && events[stack.back()].start + events[stack.back()].duration <= e.start)
+			stack.pop_back();
+
+		bool nested = false;
+		for(size_t i : stack)
+			nested |= std::strcmp(events[i].name, e.name) == 0;
+		if(!nested)
+			totals[e.name].inclusive += e.duration;
+
+		stack.push_back(&e - events.data());
+	}
+
+	std::vector<std::pair<std::string, Total>> sorted(totals.begin(), totals.end());
+	boost::sort(sorted, [](const std::pair<std::string, Total> & lhs, const std::pair<std::string, Total> & rhs)
+	{
+		return lhs.second.exclusive > rhs.second.exclusive;
+	});
+
+	const size_t SUMMARY_SIZE = 10;
+	logAi->info("Profile of %s turn on day %d, %d ms total:", player, day, turnDuration / 1000);
+	for(size_t i = 0; i < sorted.size() && i < SUMMARY_SIZE; i++)
+	{
+		const Total & t = sorted[i].second;
+		logAi->info("\t%s: %d calls, %d ms self, %d ms total", sorted[i].first, t.count, t.exclusive / 1000, t.inclusive / 1000);
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+/*
+ * AIProfiler.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+/// Hierarchical wall-clock profiler of AI turns. When enabled, every turn is written as trace in
+/// Chrome trace event format (viewable in chrome://tracing, speedscope and similar flame graph tools)
+/// and summary of most expensive scopes is logged. When disabled, scopes cost single bool check.
+/// Only scopes opened on thread that started the turn are recorded.
+class AIProfiler
+{
+public:
+	class Scope
+	{
+	public:
+		Scope(AIProfiler & owner, const char * name);
+		~Scope();
+
+		bool isActive() const { return profiler != nullptr; }
+		/// additional description of this scope instance, stored in trace but not used for summary
+		void setDetail(const std::string & detail);
+
+	private:
+		AIProfiler * profiler;
+		size_t event;
+	};
+
+	AIProfiler();
+
+	void setEnabled(bool on);
+	bool isEnabled() const { return enabled; }
+
+	void beginTurn(const std::string & player, int day);
+	/// writes trace of turn to cache directory and logs summary
+	void endTurn();
+
+private:
+	struct Event
+	{
+		const char * name;
+		std::string detail;
+		si64 start; //in microseconds since start of turn
+		si64 duration;
+		si64 childrenDuration;
+	};
+
+	bool enabled;
+	std::string player;
+	int day;
+	boost::posix_time::ptime turnStart;
+	std::vector<Event> events;
+	std::vector<size_t> openEvents;
+
+	bool isRecording() const;
+	si64 now() const;
+	size_t openEvent(const char * name);
+	void closeEvent(size_t index);
+
+	void writeTrace() const;
+	void logSummary() const;
+};
+
+#define AI_PROFILE_SCOPE(name) AIProfiler::Scope profileScope(ai->profiler, name)
@@ -24,7 +24,7 @@
 
 extern boost::thread_specific_ptr<CCallback> cb;
 extern boost::thread_specific_ptr<VCAI> ai;
-extern FuzzyHelper *fh;
+extern boost::thread_specific_ptr<FuzzyHelper> fh;
 
 //extern static const int3 dirs[8];
 
@@ -215,8 +215,11 @@ ui64 evaluateDanger(crint3 tile)
 	return std::max(objectDanger, guardDanger);
 }
 
-ui64 evaluateDanger(crint3 tile, const CGHeroInstance *visitor)
+ui64 evaluateDanger(crint3 tile, const CGHeroInstance *visitor, FuzzyHelper * fuzzy)
 {
+	if(!fuzzy)
+		fuzzy = fh.get();
+
 	const TerrainTile *t = cb->getTile(tile, false);
 	if(!t) //we can know about guard but can't check its tile (the edge of fow)
 		return 190000000; //MUCH
@@ -233,14 +236,14 @@ ui64 evaluateDanger(crint3 tile, const CGHeroInstance *visitor)
 
 	if(const CGObjectInstance * dangerousObject = vstd::backOrNull(visitableObjects))
 	{
-		objectDanger = evaluateDanger(dangerousObject); //unguarded objects can also be dangerous or unhandled
+		objectDanger = evaluateDanger(dangerousObject, fuzzy); //unguarded objects can also be dangerous or unhandled
 		if (objectDanger)
 		{
 			//TODO: don't downcast objects AI shouldn't know about!
 			auto armedObj = dynamic_cast<const CArmedInstance*>(dangerousObject);
 			if (armedObj)
 			{
-				float tacticalAdvantage = fh->getTacticalAdvantage(visitor, armedObj);
+				float tacticalAdvantage = fuzzy->getTacticalAdvantage(visitor, armedObj);
 				objectDanger *= tacticalAdvantage; //this line tends to go infinite for allied towns (?)
 			}
 		}
@@ -252,8 +255,8 @@ ui64 evaluateDanger(crint3 tile, const CGHeroInstance *visitor)
 				auto guards = cb->getGuardingCreatures(it->second->visitablePos());
 				for (auto cre : guards)
 				{
-					vstd::amax (guardDanger, evaluateDanger(cre) *
-						fh->getTacticalAdvantage(visitor, dynamic_cast<const CArmedInstance*>(cre)));
+					vstd::amax (guardDanger, evaluateDanger(cre, fuzzy) *
+						fuzzy->getTacticalAdvantage(visitor, dynamic_cast<const CArmedInstance*>(cre)));
 				}
 			}
 		}
@@ -262,7 +265,7 @@ ui64 evaluateDanger(crint3 tile, const CGHeroInstance *visitor)
 	auto guards = cb->getGuardingCreatures(tile);
 	for (auto cre : guards)
 	{
-		vstd::amax (guardDanger, evaluateDanger(cre) * fh->getTacticalAdvantage(visitor, dynamic_cast<const CArmedInstance*>(cre))); //we are interested in strongest monster around
+		vstd::amax (guardDanger, evaluateDanger(cre, fuzzy) * fuzzy->getTacticalAdvantage(visitor, dynamic_cast<const CArmedInstance*>(cre))); //we are interested in strongest monster around
 	}
 
 
@@ -270,8 +273,11 @@ ui64 evaluateDanger(crint3 tile, const CGHeroInstance *visitor)
 	return std::max(objectDanger, guardDanger);
 }
 
-ui64 evaluateDanger(const CGObjectInstance *obj)
+ui64 evaluateDanger(const CGObjectInstance *obj, FuzzyHelper * fuzzy)
 {
+	if(!fuzzy)
+		fuzzy = fh.get();
+
 	if(obj->tempOwner < PlayerColor::PLAYER_LIMIT && cb->getPlayerRelations(obj->tempOwner, ai->playerID) != PlayerRelations::ENEMIES) //owned or allied objects don't pose any threat
 		return 0;
 
@@ -314,11 +320,11 @@ ui64 evaluateDanger(const CGObjectInstance *obj)
 	case Obj::SHIPWRECK: //shipwreck
 	case Obj::DERELICT_SHIP: //derelict ship
 //	case Obj::PYRAMID:
-		return fh->estimateBankDanger (dynamic_cast<const CBank *>(obj));
+		return fuzzy->estimateBankDanger (dynamic_cast<const CBank *>(obj));
 	case Obj::PYRAMID:
 		{
 		    if(obj->subID == 0)
-				return fh->estimateBankDanger (dynamic_cast<const CBank *>(obj));
+				return fuzzy->estimateBankDanger (dynamic_cast<const CBank *>(obj));
 			else
 				return 0;
 		}
@@ -20,6 +20,7 @@
  */
 
 class CCallback;
+class FuzzyHelper;
 
 typedef const int3& crint3;
 typedef const std::string& crstring;
@@ -151,8 +152,8 @@ bool isBlockVisitObj(const int3 &pos);
 bool isWeeklyRevisitable (const CGObjectInstance * obj);
 bool shouldVisit (HeroPtr h, const CGObjectInstance * obj);
 
-ui64 evaluateDanger(const CGObjectInstance *obj);
-ui64 evaluateDanger(crint3 tile, const CGHeroInstance *visitor);
+ui64 evaluateDanger(const CGObjectInstance *obj, FuzzyHelper * fuzzy = nullptr); //global fuzzy helper is used if not given
+ui64 evaluateDanger(crint3 tile, const CGHeroInstance *visitor, FuzzyHelper * fuzzy = nullptr); //global fuzzy helper is used if not given
 bool isSafeToVisit(HeroPtr h, crint3 tile);
 bool boundaryBetweenTwoPoints (int3 pos1, int3 pos2, CCallback * cbp);
 
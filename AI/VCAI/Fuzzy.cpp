@@ -32,7 +32,12 @@ class CGTownInstance;
 
 //using namespace Goals;
 
-FuzzyHelper *fh;
+static void keepFuzzyHelper(FuzzyHelper *)
+{
+	//helper is owned by VCAI, thread only points to it
+}
+
+boost::thread_specific_ptr<FuzzyHelper> fh(&keepFuzzyHelper);
 
 extern boost::thread_specific_ptr<CCallback> cb;
 extern boost::thread_specific_ptr<VCAI> ai;
@@ -46,6 +51,38 @@ void engineBase::configure()
 {
 	engine.configure("Minimum", "Maximum", "Minimum", "AlgebraicSum", "Centroid");
 	logAi->info(engine.toString());
+
+	if (!compiled.compile(engine))
+	{
+		logAi->warn("Fuzzy engine can't be compiled, fuzzylite will be used");
+		return;
+	}
+
+	//make sure we match fuzzylite, random inputs from fixed seed
+	std::minstd_rand rand(1337);
+	fl::scalar maxError = 0;
+	for (int i = 0; i < 100; i++)
+	{
+		for (int j = 0; j < engine.numberOfInputVariables(); j++)
+		{
+			fl::InputVariable * input = engine.getInputVariable(j);
+			input->setInputValue(std::uniform_real_distribution<fl::scalar>(input->getMinimum(), input->getMaximum())(rand));
+		}
+		engine.process();
+		fl::scalar expected = engine.getOutputVariable(0)->getOutputValue();
+		fl::scalar result = compiled.process();
+		if (fl::Op::isNaN(expected) != fl::Op::isNaN(result))
+			maxError = fl::inf;
+		else if (!fl::Op::isNaN(expected))
+			vstd::amax(maxError, std::abs(expected - result));
+	}
+
+	const fl::scalar MAX_ERROR = 1e-6;
+	if (maxError > MAX_ERROR)
+	{
+		logAi->warn("Compiled fuzzy engine differs from fuzzylite by %f, fuzzylite will be used", maxError);
+		compiled = CompiledFuzzyEngine();
+	}
 }
 
 void engineBase::addRule(const std::string &txt)
@@ -53,6 +90,205 @@ void engineBase::addRule(const std::string &txt)
 	rules.addRule(fl::Rule::parse(txt, &engine));
 }
 
+void engineBase::process()
+{
+	if (compiled.isCompiled())
+		engine.getOutputVariable(0)->setOutputValue(compiled.process());
+	else
+		engine.process();
+}
+
+CompiledFuzzyEngine::CompiledFuzzyEngine() : compiled(false), minimum(0), maximum(0), defaultValue(fl::nan), lockInRange(false)
+{
+}
+
+bool CompiledFuzzyEngine::compile(const fl::Engine & engine)
+{
+	*this = CompiledFuzzyEngine();
+
+	if (engine.numberOfOutputVariables() != 1 || engine.numberOfRuleBlocks() != 1)
+		return false;
+
+	const fl::RuleBlock * block = engine.getRuleBlock(0);
+	const fl::OutputVariable * output = engine.getOutputVariable(0);
+	auto centroid = dynamic_cast<const fl::Centroid *>(output->getDefuzzifier());
+	if (!block->getConjunction() || block->getConjunction()->className() != "Minimum"
+		|| (block->getDisjunction() && block->getDisjunction()->className() != "Maximum")
+		|| !block->getActivation() || block->getActivation()->className() != "Minimum"
+		|| !output->fuzzyOutput()->getAccumulation() || output->fuzzyOutput()->getAccumulation()->className() != "AlgebraicSum"
+		|| !centroid || output->isLockedPreviousOutputValue())
+		return false;
+
+	minimum = output->getMinimum();
+	maximum = output->getMaximum();
+	defaultValue = output->getDefaultValue();
+	lockInRange = output->isLockedOutputValueInRange();
+
+	//same points as in fl::Centroid::defuzzify
+	const int resolution = centroid->getResolution();
+	const fl::scalar dx = (maximum - minimum) / resolution;
+	for (int i = 0; i < resolution; i++)
+		samplePoints.push_back(minimum + (i + 0.5) * dx);
+
+	std::vector<const fl::Term *> terms;
+	for (int i = 0; i < block->numberOfRules(); i++)
+	{
+		const fl::Rule * rule = block->getRule(i);
+		if (!rule->isLoaded() || rule->getConsequent()->conclusions().size() != 1)
+			return false;
+
+		CompiledRule compiledRule;
+		if (!compileExpression(rule->getAntecedent()->getExpression(), compiledRule.antecedent)
+			|| stackSize(compiledRule.antecedent) > MAX_STACK_SIZE)
+			return false;
+		compiledRule.weight = rule->getWeight();
+
+		const fl::Proposition * conclusion = rule->getConsequent()->conclusions().front();
+		compiledRule.hedges.assign(conclusion->hedges.rbegin(), conclusion->hedges.rend());
+
+		auto term = std::find(terms.begin(), terms.end(), conclusion->term);
+		compiledRule.term = term - terms.begin();
+		if (term == terms.end())
+		{
+			terms.push_back(conclusion->term);
+			std::vector<fl::scalar> samples;
+			for (fl::scalar x : samplePoints)
+				samples.push_back(conclusion->term->membership(x));
+			sampledTerms.push_back(samples);
+		}
+		rules.push_back(compiledRule);
+	}
+
+	compiled = true;
+	return true;
+}
+
+bool CompiledFuzzyEngine::compileExpression(const fl::Expression * expression, std::vector<Node> & out)
+{
+	Node node;
+	node.variable = nullptr;
+	node.term = nullptr;
+
+	if (auto proposition = dynamic_cast<const fl::Proposition *>(expression))
+	{
+		node.type = Node::PROPOSITION;
+		node.variable = dynamic_cast<const fl::InputVariable *>(proposition->variable);
+		node.term = proposition->term;
+		if (!node.variable || !node.variable->isEnabled())
+			return false;
+		for (auto hedge = proposition->hedges.rbegin(); hedge != proposition->hedges.rend(); ++hedge)
+		{
+			if (dynamic_cast<const fl::Any *>(*hedge))
+				return false;
+			node.hedges.push_back(*hedge);
+		}
+	}
+	else if (auto op = dynamic_cast<const fl::Operator *>(expression))
+	{
+		if (!op->left || !op->right || !compileExpression(op->left, out) || !compileExpression(op->right, out))
+			return false;
+		if (op->name == fl::Rule::andKeyword())
+			node.type = Node::AND;
+		else if (op->name == fl::Rule::orKeyword())
+			node.type = Node::OR;
+		else
+			return false;
+	}
+	else
+		return false;
+
+	out.push_back(node);
+	return true;
+}
+
+size_t CompiledFuzzyEngine::stackSize(const std::vector<Node> & antecedent)
+{
+	size_t top = 0, size = 0;
+	for (const Node & node : antecedent)
+	{
+		if (node.type == Node::PROPOSITION)
+			vstd::amax(size, ++top);
+		else
+			top--;
+	}
+	return size;
+}
+
+bool CompiledFuzzyEngine::isCompiled() const
+{
+	return compiled;
+}
+
+fl::scalar CompiledFuzzyEngine::activationDegree(const CompiledRule & rule) const
+{
+	fl::scalar stack[MAX_STACK_SIZE];
+	size_t top = 0;
+	for (const Node & node : rule.antecedent)
+	{
+		switch (node.type)
+		{
+		case Node::PROPOSITION:
+			{
+				fl::scalar degree = node.term->membership(node.variable->getInputValue());
+				for (auto hedge : node.hedges)
+					degree = hedge->hedge(degree);
+				assert(top < MAX_STACK_SIZE);
+				stack[top++] = degree;
+			}
+			break;
+		case Node::AND:
+			top--;
+			stack[top - 1] = fl::Op::min(stack[top - 1], stack[top]);
+			break;
+		case Node::OR:
+			top--;
+			stack[top - 1] = fl::Op::max(stack[top - 1], stack[top]);
+			break;
+		}
+	}
+	return rule.weight * stack[0];
+}
+
+fl::scalar CompiledFuzzyEngine::process() const
+{
+	assert(compiled);
+
+	activated.clear();
+	for (const CompiledRule & rule : rules)
+	{
+		fl::scalar degree = activationDegree(rule);
+		if (fl::Op::isGt(degree, 0.0))
+		{
+			for (auto hedge : rule.hedges)
+				degree = hedge->hedge(degree);
+			activated.push_back(std::make_pair(degree, rule.term));
+		}
+	}
+
+	fl::scalar result = defaultValue;
+	if (!activated.empty())
+	{
+		//accumulated output of activated terms, see fl::Centroid::defuzzify
+		fl::scalar area = 0, xcentroid = 0;
+		for (size_t i = 0; i < samplePoints.size(); i++)
+		{
+			fl::scalar y = 0;
+			for (auto & term : activated)
+			{
+				fl::scalar membership = fl::Op::min(sampledTerms[term.second][i], term.first);
+				y = y + membership - (y * membership);
+			}
+			xcentroid += y * samplePoints[i];
+			area += y;
+		}
+		result = fl::Op::isFinite(minimum + maximum) ? xcentroid / area : fl::nan;
+	}
+
+	if (lockInRange)
+		result = fl::Op::bound(result, minimum, maximum);
+	return result;
+}
+
 struct armyStructure
 {
 	float walkers, shooters, flyers;
@@ -256,7 +492,7 @@ float FuzzyHelper::getTacticalAdvantage (const CArmedInstance *we, const CArmedI
 			ta.castleWalls->setInputValue(0);
 
 		//engine.process(TACTICAL_ADVANTAGE);//TODO: Process only Tactical_Advantage
-		ta.engine.process();
+		ta.process();
 		output = ta.threat->getOutputValue();
 	}
 	catch (fl::Exception & fe)
@@ -302,8 +538,6 @@ Goals::TSubgoal FuzzyHelper::chooseSolution (Goals::TGoalVec vec)
 	if (vec.empty()) //no possibilities found
 		return sptr(Goals::Invalid());
 
-	ai->cachedSectorMaps.clear();
-
 	//a trick to switch between heroes less often - calculatePaths is costly
 	auto sortByHeroes = [](const Goals::TSubgoal & lhs, const Goals::TSubgoal & rhs) -> bool
 	{
@@ -311,9 +545,9 @@ Goals::TSubgoal FuzzyHelper::chooseSolution (Goals::TGoalVec vec)
 	};
 	boost::sort (vec, sortByHeroes);
 
-	for (auto g : vec)
 	{
-		setPriority(g);
+		AI_PROFILE_SCOPE("FuzzyHelper::evaluateGoals");
+		evaluateGoals(vec);
 	}
 
 	auto compareGoals = [](const Goals::TSubgoal & lhs, const Goals::TSubgoal & rhs) -> bool
@@ -325,6 +559,74 @@ Goals::TSubgoal FuzzyHelper::chooseSolution (Goals::TGoalVec vec)
 	return vec.back();
 }
 
+bool FuzzyHelper::canEvaluateInParallel(const Goals::TSubgoal & g)
+{
+	//evaluation of other goals may change state of AI (eg. sector map or boats)
+	return g->goalType == Goals::VISIT_TILE || g->goalType == Goals::VISIT_HERO;
+}
+
+void FuzzyHelper::evaluateGoals (Goals::TGoalVec & vec)
+{
+	const size_t GOALS_PER_WORKER = 16; //starting threads is not worth it for few goals
+
+	Goals::TGoalVec parallelGoals;
+	for (auto g : vec)
+	{
+		if (canEvaluateInParallel(g))
+			parallelGoals.push_back(g);
+		else
+			setPriority(g);
+	}
+
+	size_t threads = std::min<size_t>(boost::thread::hardware_concurrency(), parallelGoals.size() / GOALS_PER_WORKER);
+	if (threads <= 1)
+	{
+		for (auto g : parallelGoals)
+			setPriority(g);
+		return;
+	}
+
+	while (workers.size() < threads)
+		workers.push_back(make_unique<FuzzyHelper>());
+
+	//game state can't change while we wait for workers - makeTurn holds gs mutex and we do not send any requests
+	VCAI * currentAI = ai.get();
+	CCallback * currentCB = cb.get();
+	std::vector<std::exception_ptr> errors(threads);
+	std::vector<Task> tasks;
+	for (size_t i = 0; i < threads; i++)
+	{
+		tasks.push_back([&, i]()
+		{
+			ai.reset(currentAI);
+			cb.reset(currentCB);
+			fh.reset(workers[i].get());
+			try
+			{
+				//goals are sorted by hero, interleave them so every worker gets similar load
+				for (size_t j = i; j < parallelGoals.size(); j += threads)
+					workers[i]->setPriority(parallelGoals[j]);
+			}
+			catch (...)
+			{
+				errors[i] = std::current_exception();
+			}
+			ai.release();
+			cb.release();
+			fh.release();
+		});
+	}
+
+	CThreadHelper helper(&tasks, threads);
+	helper.run();
+
+	for (auto & error : errors)
+	{
+		if (error)
+			std::rethrow_exception(error);
+	}
+}
+
 float FuzzyHelper::evaluate (Goals::Explore & g)
 {
 	return 1;
@@ -434,10 +736,10 @@ float FuzzyHelper::evaluate (Goals::VisitTile & g)
 
 	float missionImportance = 0;
 	if (vstd::contains(ai->lockedHeroes, g.hero))
-		missionImportance = ai->lockedHeroes[g.hero]->priority;
+		missionImportance = ai->lockedHeroes.at(g.hero)->priority; //may run in worker thread, do not use operator[]
 
 	float strengthRatio = 10.0f; //we are much stronger than enemy
-	ui64 danger = evaluateDanger (g.tile, g.hero.h);
+	ui64 danger = evaluateDanger (g.tile, g.hero.h, this);
 	if (danger)
 		strengthRatio = (fl::scalar)g.hero.h->getTotalStrength() / danger;
 
@@ -448,7 +750,7 @@ float FuzzyHelper::evaluate (Goals::VisitTile & g)
 		vt.turnDistance->setInputValue(turns);
 		vt.missionImportance->setInputValue(missionImportance);
 
-		vt.engine.process();
+		vt.process();
 		//engine.process(VISIT_TILE); //TODO: Process only Visit_Tile
 		g.priority = vt.value->getOutputValue();
 	}
@@ -528,5 +830,6 @@ float FuzzyHelper::evaluate (Goals::AbstractGoal & g)
 }
 void FuzzyHelper::setPriority (Goals::TSubgoal & g)
 {
+	AI_PROFILE_SCOPE("FuzzyHelper::evaluate");
 	g->setpriority(g->accept(this)); //this enforces returned value is set
 }
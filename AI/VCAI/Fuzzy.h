@@ -17,15 +17,59 @@ class CArmedInstance;
 class CBank;
 struct SectorMap;
 
+/// Evaluates Mamdani engine with one output and one rule block without generic fuzzylite machinery.
+/// Rules are flattened and output terms are sampled in points used by centroid defuzzifier,
+/// so result is the same as of fl::Engine::process() up to rounding.
+class CompiledFuzzyEngine
+{
+	struct Node
+	{
+		enum EType {PROPOSITION, AND, OR} type;
+		const fl::InputVariable * variable;
+		const fl::Term * term;
+		std::vector<const fl::Hedge *> hedges;
+	};
+
+	struct CompiledRule
+	{
+		std::vector<Node> antecedent; //in postfix order
+		fl::scalar weight;
+		std::vector<const fl::Hedge *> hedges; //of consequent, modify activation degree
+		size_t term; //index in sampledTerms
+	};
+
+	static const size_t MAX_STACK_SIZE = 16; //rules with deeper antecedents are left to fuzzylite
+
+	bool compiled;
+	std::vector<CompiledRule> rules;
+	std::vector<fl::scalar> samplePoints;
+	std::vector<std::vector<fl::scalar>> sampledTerms;
+	fl::scalar minimum, maximum, defaultValue;
+	bool lockInRange;
+	mutable std::vector<std::pair<fl::scalar, size_t>> activated; //degree and term of activated rules
+
+	bool compileExpression(const fl::Expression * expression, std::vector<Node> & out);
+	static size_t stackSize(const std::vector<Node> & antecedent); //values kept at once while evaluating antecedent
+	fl::scalar activationDegree(const CompiledRule & rule) const;
+
+public:
+	CompiledFuzzyEngine();
+	bool compile(const fl::Engine & engine); //false if engine uses anything else than Minimum/Maximum/AlgebraicSum/Centroid
+	bool isCompiled() const;
+	fl::scalar process() const; //uses current input values of engine
+};
+
 class engineBase
 {
 public:
 	fl::Engine engine;
 	fl::RuleBlock rules;
+	CompiledFuzzyEngine compiled;
 
 	engineBase();
 	void configure();
 	void addRule(const std::string &txt);
+	void process(); //like engine.process(), but compiled if possible
 };
 
 class FuzzyHelper
@@ -55,7 +99,9 @@ class FuzzyHelper
 		~EvalVisitTile();
 	} vt;
 
-	
+	std::vector<std::unique_ptr<FuzzyHelper>> workers; //fuzzylite engines are not thread-safe, every worker thread has own helper
+
+	static bool canEvaluateInParallel(const Goals::TSubgoal & g);
 
 public:
 	enum RuleBlocks {BANK_DANGER, TACTICAL_ADVANTAGE, VISIT_TILE};
@@ -83,5 +129,6 @@ public:
 	float getTacticalAdvantage (const CArmedInstance *we, const CArmedInstance *enemy); //returns factor how many times enemy is stronger than us
 
 	Goals::TSubgoal chooseSolution (Goals::TGoalVec vec);
+	void evaluateGoals (Goals::TGoalVec & vec); //sets priority of all goals, goals which only read game state are evaluated in parallel
 	//std::shared_ptr<AbstractGoal> chooseSolution (std::vector<std::shared_ptr<AbstractGoal>> & vec);
 };
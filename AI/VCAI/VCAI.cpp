@@ -23,7 +23,7 @@
  *
  */
 
-extern FuzzyHelper *fh;
+extern boost::thread_specific_ptr<FuzzyHelper> fh;
 
 class CGVisitableOPW;
 
@@ -46,11 +46,13 @@ struct SetGlobalState
 
 		ai.reset(AI);
 		cb.reset(AI->myCb.get());
+		fh.reset(AI->fuzzyHelper.get());
 	}
 	~SetGlobalState()
 	{
 		ai.release();
 		cb.release();
+		fh.release();
 	}
 };
 
@@ -81,11 +83,13 @@ struct ObjInfo
 };
 
 std::map<const CGObjectInstance *, ObjInfo> helperObjInfo;
+boost::mutex helperObjInfoMx; //shared by all AI players
 
 VCAI::VCAI(void)
 {
 	LOG_TRACE(logAi);
 	makingTurn = nullptr;
+	fuzzyHelper = make_unique<FuzzyHelper>();
 	destinationTeleport = ObjectInstanceID();
 	destinationTeleportPos = int3(-1);
 }
@@ -109,10 +113,14 @@ void VCAI::heroMoved(const TryMoveHero & details)
 
 	validateObject(details.id); //enemy hero may have left visible area
 	auto hero = cb->getHero(details.id);
-	cachedSectorMaps.clear();
 
 	const int3 from = CGHeroInstance::convertPosition(details.start, false),
 		to = CGHeroInstance::convertPosition(details.end, false);
+	if(cachedSectorMap)
+	{
+		cachedSectorMap->invalidateTile(from);
+		cachedSectorMap->invalidateTile(to);
+	}
 	const CGObjectInstance *o1 = vstd::frontOrNull(cb->getVisitableObjs(from)),
 		*o2 = vstd::frontOrNull(cb->getVisitableObjs(to));
 
@@ -297,6 +305,11 @@ void VCAI::tileHidden(const std::unordered_set<int3, ShashInt3> &pos)
 
 	validateVisitableObjs();
 	clearPathsInfo();
+	if(cachedSectorMap)
+	{
+		for(int3 tile : pos)
+			cachedSectorMap->invalidateTile(tile);
+	}
 }
 
 void VCAI::tileRevealed(const std::unordered_set<int3, ShashInt3> &pos)
@@ -308,6 +321,11 @@ void VCAI::tileRevealed(const std::unordered_set<int3, ShashInt3> &pos)
 			addVisitableObj(obj);
 
 	clearPathsInfo();
+	if(cachedSectorMap)
+	{
+		for(int3 tile : pos)
+			cachedSectorMap->invalidateTile(tile);
+	}
 }
 
 void VCAI::heroExchangeStarted(ObjectInstanceID hero1, ObjectInstanceID hero2, QueryID query)
@@ -397,7 +415,7 @@ void VCAI::newObject(const CGObjectInstance * obj)
 	if(obj->isVisitable())
 		addVisitableObj(obj);
 
-	cachedSectorMaps.clear();
+	invalidateSectorMap(obj);
 }
 
 void VCAI::objectRemoved(const CGObjectInstance *obj)
@@ -424,7 +442,7 @@ void VCAI::objectRemoved(const CGObjectInstance *obj)
 		}
 	}
 
-	cachedSectorMaps.clear(); //invalidate all paths
+	invalidateSectorMap(obj); //object is still on map, its tiles will be checked on next use
 
 	//TODO
 	//there are other places where CGObjectinstance ptrs are stored...
@@ -588,8 +606,7 @@ void VCAI::init(std::shared_ptr<CCallback> CB)
 	myCb->waitTillRealize = true;
 	myCb->unlockGsWhenWaiting = true;
 
-	if(!fh)
-		fh = new FuzzyHelper();
+	profiler.setEnabled(settings["session"]["profileAI"].Bool());
 
 	retreiveVisitableObjs();
 }
@@ -749,6 +766,8 @@ void VCAI::makeTurn()
 	boost::shared_lock<boost::shared_mutex> gsLock(cb->getGsMutex());
 	setThreadName("VCAI::makeTurn");
 
+	profiler.beginTurn(playerID.getStr(), cb->getDate(Date::DAY));
+
 	switch(cb->getDate(Date::DAY_OF_WEEK))
 	{
 		case 1:
@@ -770,6 +789,7 @@ void VCAI::makeTurn()
 	markHeroAbleToExplore (primaryHero());
 
 	makeTurnInternal();
+	profiler.endTurn();
 	makingTurn.reset();
 
 	return;
@@ -777,6 +797,7 @@ void VCAI::makeTurn()
 
 void VCAI::makeTurnInternal()
 {
+	AI_PROFILE_SCOPE("VCAI::makeTurnInternal");
 	saving = 0;
 
 	//it looks messy here, but it's better to have armed heroes before attempting realizing goals
@@ -1678,6 +1699,7 @@ void VCAI::battleEnd(const BattleResult *br)
 
 void VCAI::waitTillFree()
 {
+	AI_PROFILE_SCOPE("VCAI::waitTillFree");
 	auto unlock = vstd::makeUnlockSharedGuard(cb->getGsMutex());
 	status.waitTillFree();
 }
@@ -1721,7 +1743,17 @@ bool VCAI::isAbleToExplore (HeroPtr h)
 void VCAI::clearPathsInfo()
 {
 	heroesUnableToExplore.clear();
-	cachedSectorMaps.clear();
+}
+
+void VCAI::invalidateSectorMap(const CGObjectInstance * obj)
+{
+	if(!cachedSectorMap)
+		return;
+
+	for(const int3 & tile : obj->getBlockedPos())
+		cachedSectorMap->invalidateTile(tile);
+	if(obj->isVisitable())
+		cachedSectorMap->invalidateTile(obj->visitablePos());
 }
 
 void VCAI::validateVisitableObjs()
@@ -1796,7 +1828,10 @@ std::vector<const CGObjectInstance *> VCAI::getFlaggedObjects() const
 void VCAI::addVisitableObj(const CGObjectInstance *obj)
 {
 	visitableObjs.insert(obj);
-	helperObjInfo[obj] = ObjInfo(obj);
+	{
+		boost::unique_lock<boost::mutex> lock(helperObjInfoMx);
+		helperObjInfo[obj] = ObjInfo(obj);
+	}
 
 	// All teleport objects seen automatically assigned to appropriate channels
 	auto teleportObj = dynamic_cast<const CGTeleport *>(obj);
@@ -1866,6 +1901,7 @@ bool VCAI::isAccessibleForHero(const int3 & pos, HeroPtr h, bool includeAllies /
 
 bool VCAI::moveHeroToTile(int3 dst, HeroPtr h)
 {
+	AI_PROFILE_SCOPE("VCAI::moveHeroToTile");
 	//TODO: consider if blockVisit objects change something in our checks: AIUtility::isBlockVisitObj()
 
 	auto afterMovementCheck = [&]() -> void
@@ -2291,6 +2327,33 @@ void VCAI::striveToGoal(Goals::TSubgoal ultimateGoal)
 	//TODO: save abstract goals not related to hero
 }
 
+static const char * decompositionScopeName(Goals::EGoals goalType)
+{
+	switch(goalType)
+	{
+	case Goals::WIN: return "Win::whatToDoToAchieve";
+	case Goals::DO_NOT_LOSE: return "DoNotLose::whatToDoToAchieve";
+	case Goals::CONQUER: return "Conquer::whatToDoToAchieve";
+	case Goals::BUILD: return "Build::whatToDoToAchieve";
+	case Goals::EXPLORE: return "Explore::whatToDoToAchieve";
+	case Goals::GATHER_ARMY: return "GatherArmy::whatToDoToAchieve";
+	case Goals::BOOST_HERO: return "BoostHero::whatToDoToAchieve";
+	case Goals::RECRUIT_HERO: return "RecruitHero::whatToDoToAchieve";
+	case Goals::BUILD_STRUCTURE: return "BuildThis::whatToDoToAchieve";
+	case Goals::COLLECT_RES: return "CollectRes::whatToDoToAchieve";
+	case Goals::GATHER_TROOPS: return "GatherTroops::whatToDoToAchieve";
+	case Goals::GET_OBJ: return "GetObj::whatToDoToAchieve";
+	case Goals::FIND_OBJ: return "FindObj::whatToDoToAchieve";
+	case Goals::VISIT_HERO: return "VisitHero::whatToDoToAchieve";
+	case Goals::GET_ART_TYPE: return "GetArtOfType::whatToDoToAchieve";
+	case Goals::ISSUE_COMMAND: return "IssueCommand::whatToDoToAchieve";
+	case Goals::VISIT_TILE: return "VisitTile::whatToDoToAchieve";
+	case Goals::CLEAR_WAY_TO: return "ClearWayTo::whatToDoToAchieve";
+	case Goals::DIG_AT_TILE: return "DigAtTile::whatToDoToAchieve";
+	default: return "AbstractGoal::whatToDoToAchieve";
+	}
+}
+
 Goals::TSubgoal VCAI::striveToGoalInternal(Goals::TSubgoal ultimateGoal, bool onlyAbstract)
 {
 	const int searchDepth = 30;
@@ -2308,7 +2371,12 @@ Goals::TSubgoal VCAI::striveToGoalInternal(Goals::TSubgoal ultimateGoal, bool on
 			try
 			{
 				boost::this_thread::interruption_point();
-				goal = goal->whatToDoToAchieve();
+				{
+					AIProfiler::Scope scope(profiler, decompositionScopeName(goal->goalType));
+					if(scope.isActive())
+						scope.setDetail(goal->name());
+					goal = goal->whatToDoToAchieve();
+				}
 				--maxGoals;
 				if (*goal == *ultimateGoal) //compare objects by value
 					throw cannotFulfillGoalException("Goal dependency loop detected!");
@@ -2795,7 +2863,8 @@ void VCAI::lostHero(HeroPtr h)
 		vstd::erase_if_present(reservedObjs, obj); //unreserve all objects for that hero
 	}
 	vstd::erase_if_present(reservedHeroesMap, h);
-	vstd::erase_if_present(cachedSectorMaps, h);
+	if(cachedSectorMap)
+		cachedSectorMap->forgetHero(h);
 }
 
 void VCAI::answerQuery(QueryID queryID, int selection)
@@ -2858,14 +2927,12 @@ TResources VCAI::freeResources() const
 
 std::shared_ptr<SectorMap> VCAI::getCachedSectorMap(HeroPtr h)
 {
-	auto it = cachedSectorMaps.find(h);
-	if (it != cachedSectorMaps.end())
-		return it->second;
+	//sectors do not depend on hero, paths of hero are made by SectorMap on demand
+	if (!cachedSectorMap)
+		cachedSectorMap = std::make_shared<SectorMap>();
 	else
-	{
-		cachedSectorMaps[h] = std::make_shared<SectorMap>(h);
-		return cachedSectorMaps[h];
-	}
+		cachedSectorMap->update();
+	return cachedSectorMap;
 }
 
 AIStatus::AIStatus()
@@ -3021,15 +3088,9 @@ bool AIStatus::channelProbing()
 	return ongoingChannelProbing;
 }
 
-SectorMap::SectorMap()
+SectorMap::SectorMap() : valid(false), revision(0), nextSectorID(3)
 {
-	update();
-}
-
-SectorMap::SectorMap(HeroPtr h)
-{
-	update();
-	makeParentBFS(h->visitablePos());
+	rebuild();
 }
 
 bool SectorMap::markIfBlocked(TSectorID &sec, crint3 pos, const TerrainTile *t)
@@ -3048,14 +3109,16 @@ bool SectorMap::markIfBlocked(TSectorID &sec, crint3 pos)
 	return markIfBlocked(sec, pos, getTile(pos));
 }
 
-void SectorMap::update()
+void SectorMap::rebuild()
 {
 	visibleTiles = cb->getAllVisibleTiles();
 	auto shape = visibleTiles->shape();
 	sector.resize(boost::extents[shape[0]][shape[1]][shape[2]]);
 
 	clear();
-	int curSector = 3; //0 is invisible, 1 is not explored
+	infoOnSectors.clear();
+	dirtyTiles.clear();
+	nextSectorID = 3; //0 is invisible, 1 is not explored
 
 	CCallback * cbp = cb.get(); //optimization
 	foreach_tile_pos([&](crint3 pos)
@@ -3063,10 +3126,107 @@ void SectorMap::update()
 		if(retreiveTile(pos) == NOT_CHECKED)
 		{
 			if(!markIfBlocked(retreiveTile(pos), pos))
-				exploreNewSector(pos, curSector++, cbp);
+				exploreNewSector(pos, nextSectorID++, cbp);
 		}
 	});
 	valid = true;
+	revision++;
+}
+
+void SectorMap::update()
+{
+	AI_PROFILE_SCOPE("SectorMap::update");
+	//sector IDs are not reused, start from scratch before they run out
+	if(!valid || nextSectorID >= std::numeric_limits<TSectorID>::max() - 1)
+	{
+		rebuild();
+		return;
+	}
+	if(dirtyTiles.empty())
+		return;
+
+	visibleTiles = cb->getAllVisibleTiles();
+	CCallback * cbp = cb.get(); //optimization
+
+	//sectors which tiles must be explored again and sectors which only need new list of objects and embarkment points
+	std::set<int> changedSectors, touchedSectors;
+	std::vector<int3> changedTiles;
+
+	for(crint3 pos : dirtyTiles)
+	{
+		if(!cbp->isInTheMap(pos))
+			continue;
+
+		const TerrainTile *t = getTile(pos);
+		TSectorID sec = retreiveTile(pos);
+		bool changed;
+		if(!t)
+			changed = sec != NOT_VISIBLE;
+		else if(t->blocked && !t->visitable)
+			changed = sec != NOT_AVAILABLE;
+		else
+			changed = sec <= NOT_AVAILABLE;
+
+		//tile may join, split or border any of sectors around
+		std::set<int> & sectors = changed ? changedSectors : touchedSectors;
+		if(sec > NOT_AVAILABLE)
+			sectors.insert(sec);
+		foreach_neighbour(cbp, pos, [&](CCallback * cbp, crint3 neighPos)
+		{
+			TSectorID neighSec = retreiveTile(neighPos);
+			if(neighSec > NOT_AVAILABLE)
+				sectors.insert(neighSec);
+		});
+
+		if(changed)
+			changedTiles.push_back(pos);
+	}
+	dirtyTiles.clear();
+
+	std::vector<int3> toExplore;
+	for(int id : changedSectors)
+	{
+		for(crint3 pos : infoOnSectors[id].tiles)
+		{
+			retreiveTile(pos) = NOT_CHECKED;
+			toExplore.push_back(pos);
+		}
+		infoOnSectors.erase(id);
+		touchedSectors.erase(id);
+	}
+	for(crint3 pos : changedTiles)
+	{
+		retreiveTile(pos) = getTile(pos) ? NOT_CHECKED : NOT_VISIBLE;
+		toExplore.push_back(pos);
+	}
+
+	//tiles of other sectors are not NOT_CHECKED, so exploration stays within changed area
+	for(crint3 pos : toExplore)
+	{
+		if(retreiveTile(pos) == NOT_CHECKED)
+		{
+			if(!markIfBlocked(retreiveTile(pos), pos))
+				exploreNewSector(pos, nextSectorID++, cbp);
+		}
+	}
+
+	for(int id : touchedSectors)
+	{
+		auto it = infoOnSectors.find(id);
+		if(it != infoOnSectors.end())
+			updateSectorInfo(it->second, cbp);
+	}
+	revision++;
+}
+
+void SectorMap::invalidateTile(crint3 pos)
+{
+	dirtyTiles.insert(pos);
+}
+
+void SectorMap::forgetHero(HeroPtr h)
+{
+	vstd::erase_if_present(parents, h);
 }
 
 SectorMap::TSectorID &SectorMap::retreiveTileN(SectorMap::TSectorArray &a, const int3 &pos)
@@ -3127,24 +3287,40 @@ void SectorMap::exploreNewSector(crint3 pos, int num, CCallback * cbp)
 							toVisit.push(neighPos);
 							//parent[neighPos] = curPos;
 						}
-						const TerrainTile *nt = getTile(neighPos);
-						if(nt && nt->isWater() != s.water && canBeEmbarkmentPoint(nt, s.water))
-						{
-							s.embarkmentPoints.push_back(neighPos);
-						}
 					});
-
-					if(t->visitable)
-					{
-						auto obj = t->visitableObjects.front();
-						if(cb->getObj(obj->id, false)) // FIXME: we have to filter invisible objcts like events, but probably TerrainTile shouldn't be used in SectorMap at all
-							s.visitableObjs.push_back(obj);
-					}
 				}
 			}
 		}
 	}
 
+	updateSectorInfo(s, cbp);
+}
+
+void SectorMap::updateSectorInfo(Sector & s, CCallback * cbp)
+{
+	s.embarkmentPoints.clear();
+	s.visitableObjs.clear();
+
+	for(crint3 pos : s.tiles)
+	{
+		foreach_neighbour(cbp, pos, [&](CCallback * cbp, crint3 neighPos)
+		{
+			const TerrainTile *nt = getTile(neighPos);
+			if(nt && nt->isWater() != s.water && canBeEmbarkmentPoint(nt, s.water))
+			{
+				s.embarkmentPoints.push_back(neighPos);
+			}
+		});
+
+		const TerrainTile *t = getTile(pos);
+		if(t->visitable)
+		{
+			auto obj = t->visitableObjects.front();
+			if(cb->getObj(obj->id, false)) // FIXME: we have to filter invisible objcts like events, but probably TerrainTile shouldn't be used in SectorMap at all
+				s.visitableObjs.push_back(obj);
+		}
+	}
+
 	vstd::removeDuplicates(s.embarkmentPoints);
 }
 
@@ -3453,6 +3629,7 @@ int3 SectorMap::findFirstVisitableTile (HeroPtr h, crint3 dst)
 {
 	int3 ret(-1,-1,-1);
 	int3 curtile = dst;
+	const ParentTree & tree = getParentTree(h);
 
 	while(curtile != h->visitablePos())
 	{
@@ -3469,11 +3646,11 @@ int3 SectorMap::findFirstVisitableTile (HeroPtr h, crint3 dst)
 		}
 		else
 		{
-			auto i = parent.find(curtile);
-			if(i != parent.end())
+			const int3 & parentTile = tree.parent[tileIndex(curtile)];
+			if(parentTile.valid())
 			{
-				assert(curtile != i->second);
-				curtile = i->second;
+				assert(curtile != parentTile);
+				curtile = parentTile;
 			}
 			else
 			{
@@ -3485,9 +3662,24 @@ int3 SectorMap::findFirstVisitableTile (HeroPtr h, crint3 dst)
 	return ret;
 }
 
-void SectorMap::makeParentBFS(crint3 source)
+size_t SectorMap::tileIndex(crint3 pos) const
+{
+	return (pos.x * sector.shape()[1] + pos.y) * sector.shape()[2] + pos.z;
+}
+
+const SectorMap::ParentTree & SectorMap::getParentTree(HeroPtr h)
+{
+	ParentTree & tree = parents[h];
+	if(tree.parent.empty() || tree.source != h->visitablePos() || tree.revision != revision)
+		makeParentBFS(h->visitablePos(), tree);
+	return tree;
+}
+
+void SectorMap::makeParentBFS(crint3 source, ParentTree & tree)
 {
-	parent.clear();
+	tree.source = source;
+	tree.revision = revision;
+	tree.parent.assign(sector.num_elements(), int3(-1, -1, -1));
 
 	int mySector = retreiveTile(source);
 	std::queue<int3> toVisit;
@@ -3502,12 +3694,13 @@ void SectorMap::makeParentBFS(crint3 source)
 
 		foreach_neighbour(curPos, [&](crint3 neighPos)
 		{
-			if(retreiveTile(neighPos) == mySector && !vstd::contains(parent, neighPos))
+			int3 & parent = tree.parent[tileIndex(neighPos)];
+			if(retreiveTile(neighPos) == mySector && !parent.valid())
 			{
 				if (cb->canMoveBetween(curPos, neighPos))
 				{
 					toVisit.push(neighPos);
-					parent[neighPos] = curPos;
+					parent = curPos;
 				}
 			}
 		});
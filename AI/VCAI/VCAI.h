@@ -1,6 +1,7 @@
 #pragma once
 
 #include "AIUtility.h"
+#include "AIProfiler.h"
 #include "Goals.h"
 #include "../../lib/AI_Base.h"
 #include "../../CCallback.h"
@@ -17,6 +18,7 @@
 #include "../../lib/CondSh.h"
 
 struct QuestInfo;
+class FuzzyHelper;
 
 /*
  * VCAI.h, part of VCMI engine
@@ -90,19 +92,33 @@ struct SectorMap
 	typedef unsigned short TSectorID; //smaller than int to allow -1 value. Max number of sectors 65K should be enough for any proper map.
 	typedef boost::multi_array<TSectorID, 3> TSectorArray;
 
+	//paths of hero to tiles of his sector, stored as flat array indexed by tileIndex
+	struct ParentTree
+	{
+		int3 source;
+		int revision; //revision of sector map tree was made for
+		std::vector<int3> parent; //invalid tile if there is no parent
+	};
+
 	bool valid; //some kind of lazy eval
-	std::map<int3, int3> parent;
+	int revision; //increased on every change of sectors or objects
+	int nextSectorID;
 	TSectorArray sector;
 	//std::vector<std::vector<std::vector<unsigned char>>> pathfinderSector;
 
 	std::map<int, Sector> infoOnSectors;
+	std::map<HeroPtr, ParentTree> parents;
+	std::set<int3> dirtyTiles; //tiles which visibility or objects changed since last update
 	std::shared_ptr<boost::multi_array<TerrainTile*, 3>> visibleTiles;
 
 	SectorMap();
-	SectorMap(HeroPtr h);
-	void update();
+	void update(); //explores again only sectors around dirty tiles
+	void rebuild();
 	void clear();
+	void invalidateTile(crint3 pos);
+	void forgetHero(HeroPtr h);
 	void exploreNewSector(crint3 pos, int num, CCallback * cbp);
+	void updateSectorInfo(Sector & s, CCallback * cbp); //embarkment points and visitable objects
 	void write(crstring fname);
 
 	bool markIfBlocked(TSectorID &sec, crint3 pos, const TerrainTile *t);
@@ -113,7 +129,9 @@ struct SectorMap
 	TerrainTile* getTile(crint3 pos) const;
 	std::vector<const CGObjectInstance *> getNearbyObjs(HeroPtr h, bool sectorsAround);
 
-	void makeParentBFS(crint3 source);
+	size_t tileIndex(crint3 pos) const;
+	const ParentTree & getParentTree(HeroPtr h);
+	void makeParentBFS(crint3 source, ParentTree & tree);
 
 	int3 firstTileToGet(HeroPtr h, crint3 dst); //if h wants to reach tile dst, which tile he should visit to clear the way?
 	int3 findFirstVisitableTile(HeroPtr h, crint3 dst);
@@ -152,11 +170,13 @@ public:
 	std::set<const CGObjectInstance *> alreadyVisited;
 	std::set<const CGObjectInstance *> reservedObjs; //to be visited by specific hero
 
-	std::map <HeroPtr, std::shared_ptr<SectorMap>> cachedSectorMaps; //TODO: serialize? not necessary
+	std::shared_ptr<SectorMap> cachedSectorMap; //shared by all heroes, updated on map changes. TODO: serialize? not necessary
 
 	TResources saving;
 
 	AIStatus status;
+	AIProfiler profiler;
+	std::unique_ptr<FuzzyHelper> fuzzyHelper; //each AI has its own, AI players may make turns simultaneously
 	std::string battlename;
 
 	std::shared_ptr<CCallback> myCb;
@@ -290,6 +310,7 @@ public:
 	void markHeroAbleToExplore (HeroPtr h);
 	bool isAbleToExplore (HeroPtr h);
 	void clearPathsInfo();
+	void invalidateSectorMap(const CGObjectInstance * obj); //blocked and visitable tiles of object have changed
 
 	void validateObject(const CGObjectInstance *obj); //checks if object is still visible and if not, removes references to it
 	void validateObject(ObjectIdRef obj); //checks if object is still visible and if not, removes references to it
@@ -242,6 +242,8 @@ int main(int argc, char** argv)
 		("ai", po::value<std::vector<std::string>>(), "AI to be used for the player, can be specified several times for the consecutive players")
 		("oneGoodAI", "puts one default AI and the rest will be EmptyAI")
 		("autoSkip", "automatically skip turns in GUI")
+		("profileAI", "writes trace of every turn of VCAI players to cache directory")
+		("maxDays", po::value<int>(), "quits game after given number of days, for AI benchmarks")
 		("disable-video", "disable video player")
 		("nointro,i", "skips intro movies")
 		("donotstartserver,d","do not attempt to start server and just connect to it instead server")
@@ -481,6 +483,8 @@ int main(int argc, char** argv)
 		session["autoSkip"].Bool()  = vm.count("autoSkip");
 		session["oneGoodAI"].Bool() = vm.count("oneGoodAI");
 		session["aiSolo"].Bool() = false;
+		session["profileAI"].Bool() = vm.count("profileAI");
+		session["maxDays"].Float() = vm.count("maxDays") ? vm["maxDays"].as<int>() : 0;
 
 		bfs::path fileToStartFrom; //none by default
 		if(vm.count("start"))
@@ -771,6 +775,42 @@ void processCommand(const std::string &message)
 		anim->preload();
 		anim->exportBitmaps(VCMIDirs::get().userCachePath() / "extracted");
 	}
+	else if(cn == "blitbench")
+	{
+		//draws all frames of given def repeatedly to offscreen surface, to measure speed of blitting
+		std::string URI;
+		int iterations = 100;
+		readed >> URI >> iterations;
+
+		auto anim = make_unique<CAnimation>(URI);
+		anim->preload();
+
+		SDL_Surface * target = CSDL_Ext::newSurface(800, 600);
+		ui64 pixels = 0;
+		size_t frames = 0;
+
+		auto start = boost::posix_time::microsec_clock::universal_time();
+		for(int i = 0; i < iterations; i++)
+		{
+			for(size_t group = 0; group < 64; group++)
+			{
+				for(size_t frame = 0; frame < anim->size(group); frame++)
+				{
+					IImage * image = anim->getImage(frame, group, false);
+					if(!image)
+						continue;
+					image->draw(target, 0, 0);
+					pixels += image->width() * image->height();
+					frames++;
+				}
+			}
+		}
+		auto end = boost::posix_time::microsec_clock::universal_time();
+		SDL_FreeSurface(target);
+
+		double ns = std::max<double>(1, (end - start).total_microseconds() * 1000.0);
+		std::cout << boost::format("%s: %d frames, %d pixels in %.0f ms, %.3f pixels/ns") % URI % frames % pixels % (ns / 1000000) % (pixels / ns) << std::endl;
+	}
 	else if(cn == "extract")
 	{
 		std::string URI;
@@ -921,6 +961,8 @@ void playIntro()
 
 void dispose()
 {
+	CBackgroundSaveFile::waitForPendingWrites();
+
 	if(VLC)
 	{
 		delete VLC;
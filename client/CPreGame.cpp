@@ -1099,6 +1099,178 @@ void SelectionTab::filter( int size, bool selectFirst )
 	}
 }
 
+static const std::string MAP_INFO_CACHE_MAGIC = "VCMIMapInfoCache2"; //increase when cache layout changes
+
+/// Persistent index of headers listed by SelectionTab, so opening the list doesn't have to parse every file again.
+/// Cached header is used as long as size and modification time of its file are the same as when it was cached.
+/// Files that can't be parsed are remembered the same way, so they don't make the cache outdated every time.
+class CMapInfoCache
+{
+public:
+	struct FileStamp
+	{
+		ui64 size;
+		si64 writeTime;
+		bool valid; //false if size or write time can't be read, such file is never cached
+
+		FileStamp() : size(0), writeTime(0), valid(true) {}
+		explicit FileStamp(const fs::path & file)
+		{
+			boost::system::error_code sizeError, timeError;
+			size = fs::file_size(file, sizeError);
+			writeTime = fs::last_write_time(file, timeError);
+			valid = !sizeError && !timeError;
+		}
+
+		bool operator==(const FileStamp & other) const
+		{
+			return size == other.size && writeTime == other.writeTime;
+		}
+
+		template <typename Handler> void serialize(Handler &h, const int version)
+		{
+			h & size & writeTime;
+		}
+	};
+
+	explicit CMapInfoCache(const std::string & name);
+
+	/// moves cached info of file to the end of items, returns false if file is not cached or has changed
+	bool take(const std::string & fileURI, const FileStamp & stamp, std::vector<CMapInfo> & items);
+	/// returns true if file could not be parsed last time and has not changed since
+	bool failedBefore(const std::string & fileURI, const FileStamp & stamp);
+	/// remembers that file can't be parsed, so it is skipped until it changes
+	void fail(const std::string & fileURI, const FileStamp & stamp);
+	/// rewrites cache with given items if they differ from cached ones, items of files not passed to take() are not cached
+	void save(const std::vector<CMapInfo> & items);
+
+private:
+	fs::path file;
+	std::map<std::string, FileStamp> cachedStamps;
+	std::map<std::string, CMapInfo> cachedInfos;
+	std::map<std::string, FileStamp> cachedFailures;
+	std::map<std::string, FileStamp> stamps; //of all listed files
+	std::map<std::string, FileStamp> failures; //of listed files that can't be parsed
+	bool outdated;
+};
+
+CMapInfoCache::CMapInfoCache(const std::string & name)
+	: file(VCMIDirs::get().userCachePath() / name), outdated(true)
+{
+	if(!fs::exists(file))
+		return;
+
+	try
+	{
+		CLoadFile cache(file);
+		cache.checkMagicBytes(MAP_INFO_CACHE_MAGIC);
+
+		// headers contain texts decoded using selected encoding
+		std::string encoding;
+		cache >> encoding;
+		if(cache.serializer.fileVersion != SERIALIZATION_VERSION || encoding != settings["general"]["encoding"].String())
+			return;
+
+		ui32 count;
+		cache >> count;
+		for(ui32 i = 0; i < count; i++)
+		{
+			std::string fileURI;
+			cache >> fileURI;
+			cache >> cachedStamps[fileURI] >> cachedInfos[fileURI];
+		}
+		cache >> cachedFailures;
+		outdated = false;
+	}
+	catch(std::exception & e)
+	{
+		logGlobal->warnStream() << "Failed to read " << file << ": " << e.what();
+		cachedStamps.clear();
+		cachedInfos.clear();
+		cachedFailures.clear();
+	}
+}
+
+bool CMapInfoCache::take(const std::string & fileURI, const FileStamp & stamp, std::vector<CMapInfo> & items)
+{
+	if(!stamp.valid)
+		return false;
+
+	stamps[fileURI] = stamp;
+
+	auto cachedStamp = cachedStamps.find(fileURI);
+	if(cachedStamp == cachedStamps.end() || !(cachedStamp->second == stamp))
+	{
+		outdated = true;
+		return false;
+	}
+
+	items.push_back(std::move(cachedInfos[fileURI]));
+	cachedInfos.erase(fileURI);
+	cachedStamps.erase(cachedStamp);
+	return true;
+}
+
+bool CMapInfoCache::failedBefore(const std::string & fileURI, const FileStamp & stamp)
+{
+	if(!stamp.valid)
+		return false;
+
+	auto cachedFailure = cachedFailures.find(fileURI);
+	if(cachedFailure == cachedFailures.end() || !(cachedFailure->second == stamp))
+		return false;
+
+	failures[fileURI] = stamp;
+	cachedFailures.erase(cachedFailure);
+	return true;
+}
+
+void CMapInfoCache::fail(const std::string & fileURI, const FileStamp & stamp)
+{
+	if(!stamp.valid)
+		return;
+
+	failures[fileURI] = stamp;
+	outdated = true;
+}
+
+void CMapInfoCache::save(const std::vector<CMapInfo> & items)
+{
+	// entries that were not taken belong to files that were removed
+	if(!outdated && cachedStamps.empty() && cachedFailures.empty())
+		return;
+
+	// unique name - more clients may run at the same time
+	const fs::path tempFile = fs::unique_path(file.string() + ".%%%%%%%%.tmp");
+	try
+	{
+		{
+			CSaveFile cache(tempFile);
+			cache.putMagicBytes(MAP_INFO_CACHE_MAGIC);
+			cache << settings["general"]["encoding"].String();
+
+			std::vector<const CMapInfo *> cachedItems;
+			for(auto & info : items)
+			{
+				if(vstd::contains(stamps, info.fileURI))
+					cachedItems.push_back(&info);
+			}
+
+			cache << static_cast<ui32>(cachedItems.size());
+			for(auto info : cachedItems)
+				cache << info->fileURI << stamps.at(info->fileURI) << *info;
+			cache << failures;
+		}
+		fs::rename(tempFile, file);
+	}
+	catch(std::exception & e)
+	{
+		logGlobal->warnStream() << "Failed to save " << file << ": " << e.what();
+		boost::system::error_code ec;
+		fs::remove(tempFile, ec);
+	}
+}
+
 std::unordered_set<ResourceID> SelectionTab::getFiles(std::string dirURI, int resType)
 {
 	boost::to_upper(dirURI);
@@ -1118,65 +1290,132 @@ std::unordered_set<ResourceID> SelectionTab::getFiles(std::string dirURI, int re
 
 void SelectionTab::parseMaps(const std::unordered_set<ResourceID> &files)
 {
-	logGlobal->debug("Parsing %d maps", files.size());
 	allItems.clear();
+	CMapInfoCache cache("mapHeaders.vcc");
+
+	std::vector<std::string> changedMaps;
+	std::map<std::string, CMapInfoCache::FileStamp> changedStamps; //of maps that have file of their own
 	for(auto & file : files)
 	{
-		try
+		// maps from archives have no file of their own and are always parsed
+		auto path = CResourceHandler::get()->getResourceName(file);
+		if(path)
 		{
-			CMapInfo mapInfo;
-			mapInfo.mapInit(file.getName());
-
-			// ignore unsupported map versions (e.g. WoG maps without WoG)
-			// but accept VCMI maps
-			if((mapInfo.mapHeader->version >= EMapFormat::VCMI) || (mapInfo.mapHeader->version <= CGI->modh->settings.data["textData"]["mapVersion"].Float()))
-				allItems.push_back(std::move(mapInfo));
+			const CMapInfoCache::FileStamp stamp(*path);
+			if(cache.failedBefore(file.getName(), stamp) || cache.take(file.getName(), stamp, allItems))
+				continue;
+			changedStamps[file.getName()] = stamp;
 		}
-		catch(std::exception & e)
+		changedMaps.push_back(file.getName());
+	}
+	logGlobal->debug("Parsing %d maps, %d maps loaded from cache", changedMaps.size(), allItems.size());
+
+	//every task fills only its own item, failed ones are left without header
+	std::vector<CMapInfo> parsedMaps(changedMaps.size());
+	std::vector<Task> tasks;
+	for(size_t i = 0; i < changedMaps.size(); i++)
+	{
+		tasks.push_back([&changedMaps, &parsedMaps, i]()
 		{
-			logGlobal->errorStream() << "Map " << file.getName() << " is invalid. Message: " << e.what();
-		}
+			try
+			{
+				parsedMaps[i].mapInit(changedMaps[i]);
+			}
+			catch(std::exception & e)
+			{
+				logGlobal->errorStream() << "Map " << changedMaps[i] << " is invalid. Message: " << e.what();
+			}
+		});
+	}
+
+	CThreadHelper helper(&tasks, std::min<ui32>(tasks.size(), std::max((ui32)1, boost::thread::hardware_concurrency())));
+	helper.run();
+
+	for(size_t i = 0; i < parsedMaps.size(); i++)
+	{
+		if(parsedMaps[i].mapHeader)
+			allItems.push_back(std::move(parsedMaps[i]));
+		else if(vstd::contains(changedStamps, changedMaps[i]))
+			cache.fail(changedMaps[i], changedStamps.at(changedMaps[i]));
 	}
+	cache.save(allItems);
+
+	// ignore unsupported map versions (e.g. WoG maps without WoG)
+	// but accept VCMI maps
+	std::vector<CMapInfo> supportedMaps;
+	for(auto & mapInfo : allItems)
+	{
+		if((mapInfo.mapHeader->version >= EMapFormat::VCMI) || (mapInfo.mapHeader->version <= CGI->modh->settings.data["textData"]["mapVersion"].Float()))
+			supportedMaps.push_back(std::move(mapInfo));
+	}
+	allItems = std::move(supportedMaps);
 }
 
 void SelectionTab::parseGames(const std::unordered_set<ResourceID> &files, bool multi)
 {
+	CMapInfoCache cache("savegameHeaders.vcc");
 	for(auto & file : files)
 	{
 		try
 		{
-			CLoadFile lf(*CResourceHandler::get()->getResourceName(file), MINIMAL_SERIALIZATION_VERSION);
-			lf.checkMagicBytes(SAVEGAME_MAGIC);
-// 			ui8 sign[8];
-// 			lf >> sign;
-// 			if(std::memcmp(sign,"VCMISVG",7))
-// 			{
-// 				throw std::runtime_error("not a correct savefile!");
-// 			}
-
-			// Create the map info object
-			CMapInfo mapInfo;
-			mapInfo.mapHeader = make_unique<CMapHeader>();
-			mapInfo.scenarioOpts = nullptr;//to be created by serialiser
-			lf >> *(mapInfo.mapHeader.get()) >> mapInfo.scenarioOpts;
-			mapInfo.fileURI = file.getName();
-			mapInfo.countPlayers();
-			std::time_t time = boost::filesystem::last_write_time(*CResourceHandler::get()->getResourceName(file));
-			mapInfo.date = std::asctime(std::localtime(&time));
-
-			// If multi mode then only multi games, otherwise single
-			if((mapInfo.actualHumanPlayers > 1) != multi)
+			const fs::path path = *CResourceHandler::get()->getResourceName(file);
+			const CMapInfoCache::FileStamp stamp(path);
+			if(cache.failedBefore(file.getName(), stamp))
+				continue;
+
+			if(!cache.take(file.getName(), stamp, allItems))
 			{
-				mapInfo.mapHeader.reset();
+				try
+				{
+					parseGame(path, file.getName());
+				}
+				catch(const std::exception &)
+				{
+					cache.fail(file.getName(), stamp);
+					throw;
+				}
 			}
 
-			allItems.push_back(std::move(mapInfo));
+			if(stamp.valid)
+			{
+				std::time_t time = stamp.writeTime;
+				allItems.back().date = std::asctime(std::localtime(&time));
+			}
 		}
 		catch(const std::exception & e)
 		{
 			logGlobal->errorStream() << "Error: Failed to process " << file.getName() <<": " << e.what();
 		}
 	}
+	cache.save(allItems);
+
+	// If multi mode then only multi games, otherwise single
+	for(auto & mapInfo : allItems)
+	{
+		if((mapInfo.actualHumanPlayers > 1) != multi)
+			mapInfo.mapHeader.reset();
+	}
+}
+
+void SelectionTab::parseGame(const fs::path & path, const std::string & fileURI)
+{
+	CLoadFile lf(path, MINIMAL_SERIALIZATION_VERSION);
+	lf.checkMagicBytes(SAVEGAME_MAGIC);
+// 	ui8 sign[8];
+// 	lf >> sign;
+// 	if(std::memcmp(sign,"VCMISVG",7))
+// 	{
+// 		throw std::runtime_error("not a correct savefile!");
+// 	}
+
+	// Create the map info object
+	CMapInfo mapInfo;
+	mapInfo.mapHeader = make_unique<CMapHeader>();
+	mapInfo.scenarioOpts = nullptr;//to be created by serialiser
+	lf >> *(mapInfo.mapHeader.get()) >> mapInfo.scenarioOpts;
+	mapInfo.fileURI = fileURI;
+	mapInfo.countPlayers();
+	allItems.push_back(std::move(mapInfo));
 }
 
 void SelectionTab::parseCampaigns(const std::unordered_set<ResourceID> &files )
@@ -156,6 +156,7 @@ private:
 
 	void parseMaps(const std::unordered_set<ResourceID> &files);
 	void parseGames(const std::unordered_set<ResourceID> &files, bool multi);
+	void parseGame(const boost::filesystem::path & path, const std::string & fileURI);
 	void parseCampaigns(const std::unordered_set<ResourceID> & files );
 	std::unordered_set<ResourceID> getFiles(std::string dirURI, int resType);
 	CMenuScreen::EState tabType;
@@ -107,7 +107,7 @@ void CClient::init()
 {
 	hotSeat = false;
 	connectionHandler = nullptr;
-	pathInfo = nullptr;
+	pathInfos.clear();
 	applier = new CApplier<CBaseForCLApply>;
 	registerTypesClientPacks1(*applier);
 	registerTypesClientPacks2(*applier);
@@ -266,6 +266,7 @@ void CClient::loadGame(const std::string & fname, const bool server, const std::
 
 	CStopWatch tmh;
 	std::unique_ptr<CLoadFile> loader;
+	CBackgroundSaveFile::waitForPendingWrites();
 	try
 	{
 		boost::filesystem::path clientSaveName = *CResourceHandler::get("local")->getResourceName(ResourceID(fname, EResType::CLIENT_SAVEGAME));
@@ -294,7 +295,7 @@ void CClient::loadGame(const std::string & fname, const bool server, const std::
 		logNetwork->infoStream() << "Loaded common part of save " << tmh.getDiff();
 		const_cast<CGameInfo*>(CGI)->mh = new CMapHandler();
 		const_cast<CGameInfo*>(CGI)->mh->map = gs->map;
-		pathInfo = make_unique<CPathsInfo>(getMapSize());
+		pathInfos.clear();
 		CGI->mh->init();
 		logNetwork->infoStream() <<"Initing maphandler: "<<tmh.getDiff();
 	}
@@ -439,7 +440,7 @@ void CClient::newGame( CConnection *con, StartInfo *si )
 		CGI->mh->map = gs->map;
 		logNetwork->infoStream() << "Creating mapHandler: " << tmh.getDiff();
 		CGI->mh->init();
-		pathInfo = make_unique<CPathsInfo>(getMapSize());
+		pathInfos.clear();
 		logNetwork->infoStream() << "Initializing mapHandler (together): " << tmh.getDiff();
 	}
 
@@ -817,26 +818,44 @@ void CClient::commenceTacticPhaseForInt(std::shared_ptr<CBattleGameInterface> ba
 void CClient::invalidatePaths()
 {
 	// turn pathfinding info into invalid. It will be regenerated later
-	boost::unique_lock<boost::mutex> pathLock(pathInfo->pathMx);
-	pathInfo->hero = nullptr;
+	boost::unique_lock<boost::mutex> lock(pathInfosMx);
+	for (auto & pathInfo : pathInfos)
+	{
+		boost::unique_lock<boost::mutex> pathLock(pathInfo.second->pathMx);
+		pathInfo.second->hero = nullptr;
+	}
 }
 
 const CPathsInfo * CClient::getPathsInfo(const CGHeroInstance *h)
 {
 	assert(h);
+	CPathsInfo * pathInfo;
+	{
+		boost::unique_lock<boost::mutex> lock(pathInfosMx);
+		auto & cached = pathInfos[h->tempOwner];
+		if (!cached)
+			cached = make_unique<CPathsInfo>(getMapSize());
+		pathInfo = cached.get();
+	}
+
 	boost::unique_lock<boost::mutex> pathLock(pathInfo->pathMx);
 	if (pathInfo->hero != h)
 	{
-		gs->calculatePaths(h, *pathInfo.get());
+		gs->calculatePaths(h, *pathInfo);
 	}
-	return pathInfo.get();
+	return pathInfo;
 }
 
 int CClient::sendRequest(const CPack *request, PlayerColor player)
 {
 	static ui32 requestCounter = 0;
+	static boost::mutex requestCounterMx; //AI players may send requests from their threads simultaneously
 
-	ui32 requestID = requestCounter++;
+	ui32 requestID;
+	{
+		boost::unique_lock<boost::mutex> lock(requestCounterMx);
+		requestID = requestCounter++;
+	}
 	logNetwork->traceStream() << boost::format("Sending a request \"%s\". It'll have an ID=%d.")
 				% typeid(*request).name() % requestID;
 
@@ -116,7 +116,8 @@ public:
 /// Class which handles client - server logic
 class CClient : public IGameCallback
 {
-	std::unique_ptr<CPathsInfo> pathInfo;
+	std::map<PlayerColor, std::unique_ptr<CPathsInfo>> pathInfos; //AI players may make turns simultaneously, so each player has its own
+	boost::mutex pathInfosMx;
 public:
 	std::map<PlayerColor,std::shared_ptr<CCallback> > callbacks; //callbacks given to player interfaces
 	std::map<PlayerColor,std::shared_ptr<CBattleCallback> > battleCallbacks; //callbacks given to player interfaces
@@ -30,6 +30,7 @@
 #include "gui/CGuiHandler.h"
 #include "widgets/MiscWidgets.h"
 #include "widgets/AdventureMapClasses.h"
+#include "windows/CAdvmapInterface.h"
 #include "CMT.h"
 
 //macros to avoid code duplication - calls given method with given arguments if interface for specific player is present
@@ -256,6 +257,13 @@ void HeroVisit::applyCl(CClient *cl)
 void NewTurn::applyCl(CClient *cl)
 {
 	cl->invalidatePaths();
+
+	const int maxDays = settings["session"]["maxDays"].Float();
+	if(maxDays && day > maxDays)
+	{
+		logGlobal->infoStream() << "Day limit of " << maxDays << " days reached, quitting";
+		handleQuit(false);
+	}
 }
 
 
@@ -335,6 +343,7 @@ void RemoveObject::applyFirstCl(CClient *cl)
 	const CGObjectInstance *o = cl->getObj(id);
 
 	CGI->mh->hideObject(o, true);
+	blockedTiles = o->getBlockedPos();
 
 	//notify interfaces about removal
 	for(auto i=cl->playerint.begin(); i!=cl->playerint.end(); i++)
@@ -347,6 +356,13 @@ void RemoveObject::applyFirstCl(CClient *cl)
 void RemoveObject::applyCl(CClient *cl)
 {
 	cl->invalidatePaths();
+
+	//object is gone from gamestate only now, minimap must not redraw its tiles earlier
+	if(adventureInt)
+	{
+		for(auto & tile : blockedTiles)
+			adventureInt->minimap.showTile(tile);
+	}
 }
 
 void TryMoveHero::applyFirstCl(CClient *cl)
@@ -792,9 +808,11 @@ void SaveGame::applyCl(CClient *cl)
 
 	try
 	{
-		CSaveFile save(*CResourceHandler::get()->getResourceName(ResourceID(stem.to_string(), EResType::CLIENT_SAVEGAME)));
+		CBackgroundSaveFile save(*CResourceHandler::get()->getResourceName(ResourceID(stem.to_string(), EResType::CLIENT_SAVEGAME)),
+			settings["general"]["compressSavegames"].Bool());
 		cl->saveCommonState(save);
 		save << *cl;
+		save.writeInBackground();
 	}
 	catch(std::exception &e)
 	{
@@ -20,6 +20,86 @@
  *
  */
 
+/// Frame of creature animation decoded from def file. Opaque pixels are stored as 32-bit pixels,
+/// shadow and selection border keep their special palette index since they change every frame
+struct CDecodedCreatureFrame
+{
+	struct Span
+	{
+		ui16 x; // offset from left edge of sprite
+		ui16 length;
+		ui8 special; // index in special palette, 0xFF for span of opaque pixels
+		ui32 firstPixel; // position of first pixel in pixels, only for opaque spans
+	};
+
+	int leftMargin, topMargin, rightMargin;
+	ui32 spriteWidth, spriteHeight;
+
+	std::vector<ui32> rowStart; // index of first span of every row, last entry is total number of spans
+	std::vector<Span> spans;
+	std::vector<ui32> pixels;
+
+	size_t memoryUsage() const
+	{
+		return sizeof(*this) + rowStart.size() * sizeof(ui32) + spans.size() * sizeof(Span) + pixels.size() * sizeof(ui32);
+	}
+};
+
+/// Decoded frames shared by all animations, keeps amount of memory set by battle/creatureFrameCache (in MB)
+/// and drops least recently used frames when it is exceeded
+class CCreatureFrameCache
+{
+	struct Entry
+	{
+		std::shared_ptr<const CDecodedCreatureFrame> frame;
+		ui64 lastUsed;
+	};
+
+	// key - def name, group, frame
+	std::map<std::tuple<std::string, int, size_t>, Entry> frames;
+	size_t usedBytes;
+	ui64 counter;
+
+public:
+	CCreatureFrameCache() : usedBytes(0), counter(0) {}
+
+	size_t getBudget() const
+	{
+		return settings["battle"]["creatureFrameCache"].Float() * 1024 * 1024;
+	}
+
+	std::shared_ptr<const CDecodedCreatureFrame> find(const std::string & def, int group, size_t frame)
+	{
+		auto it = frames.find(std::make_tuple(def, group, frame));
+		if(it == frames.end())
+			return nullptr;
+
+		it->second.lastUsed = ++counter;
+		return it->second.frame;
+	}
+
+	void insert(const std::string & def, int group, size_t frame, std::shared_ptr<const CDecodedCreatureFrame> decoded)
+	{
+		usedBytes += decoded->memoryUsage();
+		frames[std::make_tuple(def, group, frame)] = Entry{decoded, ++counter};
+
+		const size_t budget = getBudget();
+		while(usedBytes > budget && frames.size() > 1)
+		{
+			auto oldest = frames.begin();
+			for(auto it = frames.begin(); it != frames.end(); ++it)
+			{
+				if(it->second.lastUsed < oldest->second.lastUsed)
+					oldest = it;
+			}
+			usedBytes -= oldest->second.frame->memoryUsage();
+			frames.erase(oldest);
+		}
+	}
+};
+
+static CCreatureFrameCache creatureFrameCache;
+
 static const SDL_Color creatureBlueBorder = { 0, 255, 255, 255 };
 static const SDL_Color creatureGoldBorder = { 255, 255, 0, 255 };
 static const SDL_Color creatureNoBorder  =  { 0, 0, 0, 0 };
@@ -376,8 +456,154 @@ void CCreatureAnimation::nextFrameT(SDL_Surface * dest, bool rotate)
 	}
 }
 
+std::shared_ptr<const CDecodedCreatureFrame> CCreatureAnimation::getDecodedFrame() const
+{
+	if(creatureFrameCache.getBudget() == 0)
+		return nullptr;
+
+	const size_t frameIndex = floor(currentFrame);
+	auto cached = creatureFrameCache.find(defName, type, frameIndex);
+	if(cached)
+		return cached;
+
+	CMemoryStream stm(pixelData.get(), pixelDataSize);
+	CBinaryReader reader(&stm);
+	reader.getStream()->seek(dataOffsets.at(type).at(frameIndex));
+
+	auto frame = std::make_shared<CDecodedCreatureFrame>();
+
+	reader.readUInt32(); // unused, size of pixel data for this frame
+	reader.readUInt32(); // def type
+	const ui32 fullWidth = reader.readUInt32();
+	reader.readUInt32(); // full height
+	frame->spriteWidth = reader.readUInt32();
+	frame->spriteHeight = reader.readUInt32();
+	frame->leftMargin = reader.readInt32();
+	frame->topMargin = reader.readInt32();
+	frame->rightMargin = fullWidth - frame->spriteWidth - frame->leftMargin;
+
+	const size_t baseOffset = reader.getStream()->tell();
+
+	auto addSpan = [&](ui16 x, ui8 special)
+	{
+		auto & spans = frame->spans;
+		bool continues = spans.size() > frame->rowStart.back() && spans.back().special == special && spans.back().x + spans.back().length == x;
+		if(continues)
+			spans.back().length++;
+		else
+			spans.push_back(CDecodedCreatureFrame::Span{x, 1, special, ui32(frame->pixels.size())});
+	};
+
+	auto addPixel = [&](ui16 x, ui8 index)
+	{
+		if(index == 0)
+			return; // fully transparent
+		if(index < 8)
+			addSpan(x, index);
+		else
+		{
+			addSpan(x, 0xFF);
+			frame->pixels.push_back(packOpaqueColor(palette[index]));
+		}
+	};
+
+	for(ui32 i = 0; i < frame->spriteHeight; i++)
+	{
+		frame->rowStart.push_back(frame->spans.size());
+
+		const ui8 * lineData = pixelData.get() + baseOffset + reader.readUInt32();
+		size_t currentOffset = 0;
+		ui32 x = 0;
+
+		while(x < frame->spriteWidth)
+		{
+			ui8 segmentType = lineData[currentOffset++];
+			ui32 length = lineData[currentOffset++] + 1;
+
+			for(size_t j = 0; j < length; j++)
+				addPixel(x + j, segmentType == 0xFF ? lineData[currentOffset + j] : segmentType);
+
+			if(segmentType == 0xFF)
+				currentOffset += length;
+			x += length;
+		}
+	}
+	frame->rowStart.push_back(frame->spans.size());
+
+	creatureFrameCache.insert(defName, type, frameIndex, frame);
+	return frame;
+}
+
+void CCreatureAnimation::drawDecodedFrame(SDL_Surface * dest, const CDecodedCreatureFrame & frame, bool rotate)
+{
+	auto specialPalette = genSpecialPalette();
+
+	// same clipping as in putPixelAt
+	const int clipRight = pos.x + pos.w;
+	const int clipBottom = pos.y + pos.h;
+
+	for(ui32 i = 0; i < frame.spriteHeight; i++)
+	{
+		const int destY = pos.y + frame.topMargin + i;
+		if(destY < 0 || destY >= clipBottom)
+			continue;
+
+		Uint32 * line = reinterpret_cast<Uint32 *>((ui8 *)dest->pixels + destY * dest->pitch);
+
+		for(ui32 s = frame.rowStart[i]; s < frame.rowStart[i + 1]; s++)
+		{
+			const CDecodedCreatureFrame::Span & span = frame.spans[s];
+
+			// pixel j of span goes to x0 + j, or to x0 - j if frame is mirrored
+			int x0, from, to;
+			if(rotate)
+			{
+				x0 = pos.x + frame.rightMargin + frame.spriteWidth - 1 - span.x;
+				from = std::max(0, x0 - clipRight + 1);
+				to = std::min<int>(span.length, x0 + 1);
+			}
+			else
+			{
+				x0 = pos.x + frame.leftMargin + span.x;
+				from = std::max(0, -x0);
+				to = std::min<int>(span.length, clipRight - x0);
+			}
+			if(from >= to)
+				continue;
+
+			if(span.special == 0xFF)
+			{
+				const ui32 * pixels = frame.pixels.data() + span.firstPixel;
+				if(rotate)
+				{
+					for(int j = from; j < to; j++)
+						line[x0 - j] = pixels[j];
+				}
+				else
+					std::copy(pixels + from, pixels + to, line + x0 + from);
+			}
+			else
+			{
+				const SDL_Color & color = specialPalette[span.special];
+				for(int j = from; j < to; j++)
+				{
+					ui8 * pixel = reinterpret_cast<ui8 *>(line + (rotate ? x0 - j : x0 + j));
+					ColorPutter<4, 0>::PutColor(pixel, color.r, color.g, color.b, color.a);
+				}
+			}
+		}
+	}
+}
+
 void CCreatureAnimation::nextFrame(SDL_Surface *dest, bool attacker)
 {
+	if(dest->format->BytesPerPixel == 4)
+	{
+		auto decoded = getDecodedFrame();
+		if(decoded)
+			return drawDecodedFrame(dest, *decoded, !attacker);
+	}
+
 	// Note: please notice that attacker value is inversed when passed further.
 	// This is intended behavior because "attacker" actually does not needs rotation
 	switch(dest->format->BytesPerPixel)
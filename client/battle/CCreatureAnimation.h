@@ -16,6 +16,7 @@
 
 class CIntObject;
 class CCreatureAnimation;
+struct CDecodedCreatureFrame;
 
 /// Namespace for some common controls of animations
 namespace AnimationControls
@@ -97,6 +98,11 @@ private:
 	template<int bpp>
 	void nextFrameT(SDL_Surface * dest, bool rotate);
 
+	/// decodes current frame or takes it from cache of decoded frames, nullptr if cache is disabled
+	std::shared_ptr<const CDecodedCreatureFrame> getDecodedFrame() const;
+	/// draws decoded frame onto 32 bpp surface
+	void drawDecodedFrame(SDL_Surface * dest, const CDecodedCreatureFrame & frame, bool rotate);
+
 	void endAnimation();
 
 	/// creates 8 special colors for current frame
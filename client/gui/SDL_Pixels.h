@@ -121,6 +121,12 @@ namespace Channels
 }
 
 
+/// Value of opaque color as 32-bit pixel, matches layout of Channels::px<4> on both byte orders
+STRONG_INLINE Uint32 packOpaqueColor(const SDL_Color & Color)
+{
+	return 0xFF000000 | ((Uint32)Color.r << 16) | ((Uint32)Color.g << 8) | (Uint32)Color.b;
+}
+
 template <int incrementPtr>
 struct ColorPutter<2, incrementPtr>
 {
@@ -197,6 +203,15 @@ STRONG_INLINE void ColorPutter<bpp, incrementPtr>::PutColor(Uint8 *&ptr, const U
 template<int bpp, int incrementPtr>
 STRONG_INLINE void ColorPutter<bpp, incrementPtr>::PutColorRow(Uint8 *&ptr, const SDL_Color & Color, size_t count)
 {
+	if (bpp == 4 && incrementPtr == 1)
+	{
+		// one 32-bit store per pixel, compilers turn this loop into vector stores
+		Uint32 * const row = reinterpret_cast<Uint32 *>(ptr);
+		std::fill(row, row + count, packOpaqueColor(Color));
+		ptr += count * 4;
+		return;
+	}
+
 	if (count)
 	{
 		Uint8 *pixel = ptr;
@@ -379,6 +379,9 @@ void CMapHandler::init()
 	offsetX = (mapW - (2*frameW+1)*32)/2;
 	offsetY = (mapH - (2*frameH+1)*32)/2;
 
+	terrainLayerCache.clear();
+	cache.discardWorldViewCache();
+
 	prepareFOWDefs();
 	initTerrainGraphics();
 	initBorderGraphics();
@@ -469,6 +472,145 @@ CMapHandler::CMapNormalBlitter::CMapNormalBlitter(CMapHandler * parent)
 	defaultTileRect = Rect(0, 0, tileSize, tileSize);
 }
 
+/// tiles with pieces of heroes that are in the middle of movement
+static bool hasMovingObject(const TerrainTile2 & tile)
+{
+	for (auto & object : tile.objects)
+	{
+		if (object.obj && object.obj->ID == Obj::HERO && !static_cast<const CGHeroInstance *>(object.obj)->isStanding)
+			return true;
+	}
+	return false;
+}
+
+/// tiles whose palette is shifted by CMapHandler::updateWater
+static bool hasAnimatedTerrain(const TerrainTile & tinfo)
+{
+	return tinfo.terType == ETerrainType::LAVA || tinfo.terType == ETerrainType::WATER
+		|| tinfo.riverType == ERiverType::CLEAR_RIVER || tinfo.riverType == ERiverType::MUDDY_RIVER || tinfo.riverType == ERiverType::LAVA_RIVER;
+}
+
+int CMapHandler::CMapBlitter::terrainBlockTiles() const
+{
+	return std::max(8, 256 / tileSize);
+}
+
+void CMapHandler::CMapBlitter::drawTerrainBlockTile(TerrainLayerBlock * block, const int3 & blockPos, const int3 & tile)
+{
+	pos = tile;
+	realPos.x = (tile.x - blockPos.x * terrainBlockTiles()) * tileSize;
+	realPos.y = (tile.y - blockPos.y * terrainBlockTiles()) * tileSize;
+	realTileRect.x = realPos.x;
+	realTileRect.y = realPos.y;
+
+	const TerrainTile & tinfo = parent->map->getTile(tile);
+	const TerrainTile * tinfoUpper = tile.y > 0 ? &parent->map->getTile(int3(tile.x, tile.y - 1, tile.z)) : nullptr;
+
+	drawTileTerrain(block->surface, tinfo, parent->ttiles[tile.x][tile.y][tile.z]);
+	if (tinfo.riverType)
+		drawRiver(block->surface, tinfo);
+	drawRoad(block->surface, tinfo, tinfoUpper);
+}
+
+CMapHandler::TerrainLayerBlock * CMapHandler::CMapBlitter::requestTerrainBlock(const int3 & blockPos)
+{
+	// keeps about 32 MB of blocks, that is enough for several screens of the biggest resolutions
+	static const size_t MAX_CACHED_BLOCKS = 128;
+
+	const int blockTiles = terrainBlockTiles();
+	auto & block = parent->terrainLayerCache[std::make_pair(tileSize, blockPos)];
+	if (!block)
+	{
+		const int sizePx = blockTiles * tileSize;
+		block = make_unique<TerrainLayerBlock>();
+		block->surface = CSDL_Ext::newSurface(sizePx, sizePx);
+		SDL_SetSurfaceBlendMode(block->surface, SDL_BLENDMODE_NONE);
+		block->waterPhase = parent->waterPhase;
+		block->scaled = info->scaled;
+
+		int3 tile(0, 0, blockPos.z);
+		for (tile.x = blockPos.x * blockTiles; tile.x < std::min((blockPos.x + 1) * blockTiles, parent->sizes.x); tile.x++)
+		{
+			for (tile.y = blockPos.y * blockTiles; tile.y < std::min((blockPos.y + 1) * blockTiles, parent->sizes.y); tile.y++)
+			{
+				drawTerrainBlockTile(block.get(), blockPos, tile);
+				// scaled images are not animated
+				if (!block->scaled && hasAnimatedTerrain(parent->map->getTile(tile)))
+					block->animatedTiles.push_back(tile);
+			}
+		}
+	}
+	else if (block->waterPhase != parent->waterPhase)
+	{
+		// only palette of water tiles has changed, everything else can stay
+		for (const int3 & tile : block->animatedTiles)
+			drawTerrainBlockTile(block.get(), blockPos, tile);
+		block->waterPhase = parent->waterPhase;
+	}
+	block->lastUsed = parent->terrainLayerFrame;
+	TerrainLayerBlock * ret = block.get();
+
+	while (parent->terrainLayerCache.size() > MAX_CACHED_BLOCKS)
+	{
+		auto oldest = parent->terrainLayerCache.begin();
+		for (auto it = parent->terrainLayerCache.begin(); it != parent->terrainLayerCache.end(); ++it)
+		{
+			if (it->second->lastUsed < oldest->second->lastUsed)
+				oldest = it;
+		}
+		if (oldest->second->lastUsed == parent->terrainLayerFrame)
+			break; // everything is on screen
+		parent->terrainLayerCache.erase(oldest);
+	}
+	return ret;
+}
+
+bool CMapHandler::CMapBlitter::drawTerrainLayer(SDL_Surface * targetSurf)
+{
+	const int BLOCK = terrainBlockTiles();
+	parent->terrainLayerFrame++;
+
+	// part of the map in viewport [in tiles]
+	const int3 first(std::max(topTile.x, 0), std::max(topTile.y, 0), topTile.z);
+	const int3 last(std::min(topTile.x + tileCount.x, parent->sizes.x) - 1, std::min(topTile.y + tileCount.y, parent->sizes.y) - 1, topTile.z);
+	if (first.x > last.x || first.y > last.y)
+		return true;
+
+	for (int blockX = first.x / BLOCK; blockX <= last.x / BLOCK; blockX++)
+	{
+		for (int blockY = first.y / BLOCK; blockY <= last.y / BLOCK; blockY++)
+		{
+			const int3 blockPos(blockX, blockY, topTile.z);
+			TerrainLayerBlock * block = requestTerrainBlock(blockPos);
+
+			const int fromX = std::max(first.x, blockX * BLOCK), toX = std::min(last.x, blockX * BLOCK + BLOCK - 1);
+			const int fromY = std::max(first.y, blockY * BLOCK), toY = std::min(last.y, blockY * BLOCK + BLOCK - 1);
+
+			// blit every row of the block as few spans of visible tiles as possible
+			pos.z = topTile.z;
+			for (pos.y = fromY; pos.y <= toY; pos.y++)
+			{
+				for (pos.x = fromX; pos.x <= toX;)
+				{
+					int spanStart = pos.x;
+					while (pos.x <= toX && (info->showAllTerrain || canDrawCurrentTile()))
+						pos.x++;
+
+					if (pos.x > spanStart)
+					{
+						Rect source((spanStart - blockX * BLOCK) * tileSize, (pos.y - blockY * BLOCK) * tileSize, (pos.x - spanStart) * tileSize, tileSize);
+						Rect dest(initPos.x + (spanStart - topTile.x) * tileSize, initPos.y + (pos.y - topTile.y) * tileSize, source.w, source.h);
+						CSDL_Ext::blitSurface(block->surface, &source, targetSurf, &dest);
+					}
+					else
+						pos.x++; // skip hidden tile
+				}
+			}
+		}
+	}
+	return true;
+}
+
 IImage * CMapHandler::CMapWorldViewBlitter::objectToIcon(Obj id, si32 subId, PlayerColor owner) const
 {
 	int ownerIndex = 0;
@@ -845,6 +987,8 @@ void CMapHandler::CMapBlitter::blit(SDL_Surface * targetSurf, const MapDrawingIn
 	init(info);
 	auto prevClip = clip(targetSurf);
 
+	const bool terrainDrawn = drawTerrainLayer(targetSurf);
+
 	pos = int3(0, 0, topTile.z);
 
 	for (realPos.x = initPos.x, pos.x = topTile.x; pos.x < topTile.x + tileCount.x; pos.x++, realPos.x += tileSize)
@@ -866,7 +1010,9 @@ void CMapHandler::CMapBlitter::blit(SDL_Surface * targetSurf, const MapDrawingIn
 			const TerrainTile & tinfo = parent->map->getTile(pos);
 			const TerrainTile * tinfoUpper = pos.y > 0 ? &parent->map->getTile(int3(pos.x, pos.y - 1, pos.z)) : nullptr;
 
-			if(isVisible || info->showAllTerrain)
+			// tiles with moving heroes get their terrain again right before objects, so parts of heroes
+			// drawn there from preceding tiles are covered in the same order as without the cached layer
+			if((!terrainDrawn || hasMovingObject(tile)) && (isVisible || info->showAllTerrain))
 			{
 				drawTileTerrain(targetSurf, tinfo, tile);
 				if (tinfo.riverType)
@@ -1317,6 +1463,8 @@ bool CMapHandler::canStartHeroMovement()
 
 void CMapHandler::updateWater() //shift colors in palettes of water tiles
 {
+	waterPhase++;
+
 	for(auto & elem : terrainImages[7])
 	{
 		for(IImage * img : elem)
@@ -1377,6 +1525,8 @@ CMapHandler::CMapHandler()
 	worldViewBlitter = new CMapWorldViewBlitter(this);
 	puzzleViewBlitter = new CMapPuzzleViewBlitter(this);
 	fadeAnimCounter = 0;
+	terrainLayerFrame = 0;
+	waterPhase = 0;
 	map = nullptr;
 	tilesW = tilesH = 0;
 	offsetX = offsetY = 0;
@@ -1414,31 +1564,55 @@ void CMapHandler::getTerrainDescr( const int3 &pos, std::string & out, bool terN
 void CMapHandler::discardWorldViewCache()
 {
 	cache.discardWorldViewCache();
+
+	// blocks composited from scaled images
+	for (auto it = terrainLayerCache.begin(); it != terrainLayerCache.end();)
+	{
+		if (it->second->scaled)
+			it = terrainLayerCache.erase(it);
+		else
+			++it;
+	}
 }
 
 CMapHandler::CMapCache::CMapCache()
 {
+	current = nullptr;
 	worldViewCachedScale = 0;
 }
 
+CMapHandler::TerrainLayerBlock::TerrainLayerBlock()
+	: surface(nullptr), scaled(false), waterPhase(0), lastUsed(0)
+{
+}
+
+CMapHandler::TerrainLayerBlock::~TerrainLayerBlock()
+{
+	if (surface)
+		SDL_FreeSurface(surface);
+}
+
 void CMapHandler::CMapCache::discardWorldViewCache()
 {
-	for(auto & cache : data)
-		cache.clear();
+	data.clear();
+	current = nullptr;
+	worldViewCachedScale = 0;
 	logAnim->debug("Discarded world view cache");
 }
 
 void CMapHandler::CMapCache::updateWorldViewScale(float scale)
 {
-	if (fabs(scale - worldViewCachedScale) > 0.001f)
-		discardWorldViewCache();
+	if (current && fabs(scale - worldViewCachedScale) <= 0.001f)
+		return;
+
 	worldViewCachedScale = scale;
+	current = &data[(int)vstd::round(scale * 1000)];
 }
 
 IImage * CMapHandler::CMapCache::requestWorldViewCacheOrCreate(CMapHandler::EMapCacheType type, const IImage * fullSurface)
 {
 	intptr_t key = (intptr_t) fullSurface;
-	auto & cache = data[(ui8)type];
+	auto & cache = (*current)[(ui8)type];
 
 	auto iter = cache.find(key);
 	if(iter == cache.end())
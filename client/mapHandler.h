@@ -156,21 +156,38 @@ class CMapHandler
 		TERRAIN, OBJECTS, ROADS, RIVERS, FOW, HEROES, HERO_FLAGS, FRAME, AFTER_LAST
 	};
 
-	/// temporarily caches rescaled frames for map world view redrawing
+	/// caches rescaled frames for map world view redrawing, separately for every used scale
 	class CMapCache
 	{
-		std::array< std::map<intptr_t, std::unique_ptr<IImage>>, (ui8)EMapCacheType::AFTER_LAST> data;
+		typedef std::array< std::unordered_map<intptr_t, std::unique_ptr<IImage>>, (ui8)EMapCacheType::AFTER_LAST> TScaledImages;
+
+		std::map<int, TScaledImages> data; //[scale in thousandths]
+		TScaledImages * current;
 		float worldViewCachedScale;
 	public:
 		CMapCache();
-		/// destroys all cached data (frees surfaces)
+		/// destroys all cached data of all scales (frees surfaces)
 		void discardWorldViewCache();
-		/// updates scale and determines if currently cached data is still valid
+		/// selects scale to use, data cached for other scales is kept so switching between them is cheap
 		void updateWorldViewScale(float scale);
 		/// asks for cached data; @returns cached data if found, new scaled surface otherwise, may return nullptr in case of scaling error
 		IImage * requestWorldViewCacheOrCreate(EMapCacheType type, const IImage * fullSurface);
 	};
 
+	/// terrain, rivers and roads of a square block of tiles composited into single surface, so map
+	/// can be drawn with few plain blits; tiles with animated water are redrawn on palette shift
+	struct TerrainLayerBlock
+	{
+		SDL_Surface * surface;
+		bool scaled; // composited from world view images
+		std::vector<int3> animatedTiles; // tiles that have to be redrawn when water animation advances
+		int waterPhase; // water animation phase the block was composited with
+		int lastUsed; // number of frame in which the block was drawn for the last time
+
+		TerrainLayerBlock();
+		~TerrainLayerBlock();
+	};
+
 	/// helper struct to pass around resolved bitmaps of an object; images can be nullptr if object doesn't have bitmap of that type
 	struct AnimBitmapHolder
 	{
@@ -212,6 +229,8 @@ class CMapHandler
 		virtual void drawRiver(SDL_Surface * targetSurf, const TerrainTile & tinfo) const;
 		/// draws a road segment on current tile
 		virtual void drawRoad(SDL_Surface * targetSurf, const TerrainTile & tinfo, const TerrainTile * tinfoUpper) const;
+		/// draws terrain, rivers and roads of all visible tiles from cached blocks; @returns false if they have to be drawn per tile
+		virtual bool drawTerrainLayer(SDL_Surface * targetSurf);
 		/// draws all objects on current tile (higher-level logic, unlike other draw*** methods)
 		virtual void drawObjects(SDL_Surface * targetSurf, const TerrainTile2 & tile) const;
 		virtual void drawObject(SDL_Surface * targetSurf, const IImage * source, SDL_Rect * sourceRect, bool moving) const;
@@ -248,6 +267,13 @@ class CMapHandler
 
 		// internal helper methods to choose correct bitmap(s) for object; called internally by findObjectBitmap
 		AnimBitmapHolder findHeroBitmap(const CGHeroInstance * hero, int anim) const;
+
+		/// size of terrain layer block side [in tiles], blocks have about the same size in pixels for all scales
+		int terrainBlockTiles() const;
+		/// @returns composited block at given position [in blocks], renders it or its animated tiles if needed
+		TerrainLayerBlock * requestTerrainBlock(const int3 & blockPos);
+		/// composites terrain, river and road of given tile into block surface
+		void drawTerrainBlockTile(TerrainLayerBlock * block, const int3 & blockPos, const int3 & tile);
 		AnimBitmapHolder findBoatBitmap(const CGBoat * hero, int anim) const;
 		IImage * findFlagBitmap(const CGHeroInstance * obj, int anim, const PlayerColor * color, int group) const;
 		IImage * findHeroFlagBitmap(const CGHeroInstance * obj, int anim, const PlayerColor * color, int group) const;
@@ -313,6 +339,9 @@ class CMapHandler
 	CMapBlitter * puzzleViewBlitter;
 
 	std::map<int, std::pair<int3, CFadeAnimation*>> fadeAnims;
+	std::map<std::pair<int, int3>, std::unique_ptr<TerrainLayerBlock>> terrainLayerCache; //[tile size, block position in blocks]
+	int terrainLayerFrame; // counts drawn frames, for eviction of least recently used blocks
+	int waterPhase; // increased on every water animation step
 	int fadeAnimCounter;
 
 	CMapBlitter * resolveBlitter(const MapDrawingInfo * info) const;
@@ -428,6 +428,18 @@ void CMinimapInstance::refreshTile(const int3 &tile)
 	blitTileWithColor(getTileColor(int3(tile.x, tile.y, level)), tile, minimap, 0, 0);
 }
 
+void CMinimapInstance::invalidateTile(const int3 &tile)
+{
+	dirtyTiles.insert(tile);
+}
+
+void CMinimapInstance::refreshDirtyTiles()
+{
+	for (auto & tile : dirtyTiles)
+		refreshTile(tile);
+	dirtyTiles.clear();
+}
+
 void CMinimapInstance::drawScaled(int level)
 {
 	int3 mapSizes = LOCPLINT->cb->getMapSize();
@@ -479,6 +491,8 @@ CMinimapInstance::~CMinimapInstance()
 
 void CMinimapInstance::showAll(SDL_Surface *to)
 {
+	//tile changes are only collected, state of gamestate is final when we are drawn
+	refreshDirtyTiles();
 	blitAtLoc(minimap, 0, 0, to);
 
 	//draw heroes
@@ -544,6 +558,15 @@ CMinimap::CMinimap(const Rect &position):
 	pos.h = position.h;
 }
 
+CMinimap::~CMinimap()
+{
+	//instances are owned by us, not by children list
+	if (minimap)
+		removeChild(minimap);
+	for (auto instance : levels)
+		delete instance;
+}
+
 int3 CMinimap::translateMousePosition()
 {
 	// 0 = top-left corner, 1 = bottom-right corner
@@ -632,12 +655,37 @@ void CMinimap::update()
 	if (aiShield) //AI turn is going on. There is no need to update minimap
 		return;
 
-	OBJ_CONSTRUCTION_CAPTURING_ALL;
-	vstd::clear_pointer(minimap);
-	minimap = new CMinimapInstance(this, level);
+	if (levels.empty())
+		levels.resize(LOCPLINT->cb->getMapSize().z, nullptr);
+
+	if (!levels[level])
+	{
+		BLOCK_CAPTURING;
+		levels[level] = new CMinimapInstance(this, level);
+	}
+
+	if (minimap != levels[level])
+	{
+		if (minimap)
+			removeChild(minimap, true);
+		minimap = levels[level];
+		addChild(minimap, true);
+		minimap->recActions = 255;
+	}
 	redraw();
 }
 
+void CMinimap::invalidate()
+{
+	if (minimap)
+		removeChild(minimap);
+	minimap = nullptr;
+
+	for (auto & instance : levels)
+		vstd::clear_pointer(instance);
+	update();
+}
+
 void CMinimap::setLevel(int newLevel)
 {
 	level = newLevel;
@@ -649,7 +697,10 @@ void CMinimap::setAIRadar(bool on)
 	if (on)
 	{
 		OBJ_CONSTRUCTION_CAPTURING_ALL;
-		vstd::clear_pointer(minimap);
+		//keep buffers, changes made during AI turn are collected and drawn when turn ends
+		if (minimap)
+			removeChild(minimap, true);
+		minimap = nullptr;
 		if (!aiShield)
 			aiShield = new CPicture("AIShield");
 	}
@@ -665,14 +716,14 @@ void CMinimap::setAIRadar(bool on)
 
 void CMinimap::hideTile(const int3 &pos)
 {
-	if (minimap)
-		minimap->refreshTile(pos);
+	if (vstd::isValidIndex(levels, pos.z) && levels[pos.z])
+		levels[pos.z]->invalidateTile(pos);
 }
 
 void CMinimap::showTile(const int3 &pos)
 {
-	if (minimap)
-		minimap->refreshTile(pos);
+	if (vstd::isValidIndex(levels, pos.z) && levels[pos.z])
+		levels[pos.z]->invalidateTile(pos);
 }
 
 CInfoBar::CVisibleInfo::CVisibleInfo(Point position):
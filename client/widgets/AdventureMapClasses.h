@@ -184,6 +184,7 @@ class CMinimapInstance : public CIntObject
 	CMinimap *parent;
 	SDL_Surface * minimap;
 	int level;
+	std::set<int3> dirtyTiles; //tiles changed since minimap was last shown
 
 	//get color of selected tile on minimap
 	const SDL_Color & getTileColor(const int3 & pos);
@@ -201,6 +202,9 @@ public:
 	void tileToPixels (const int3 &tile, int &x, int &y,int toX = 0, int toY = 0);
 
 	void refreshTile(const int3 &pos);
+	//tile will be redrawn next time minimap is shown
+	void invalidateTile(const int3 &pos);
+	void refreshDirtyTiles();
 };
 
 /// Minimap which is displayed at the right upper corner of adventure map
@@ -209,7 +213,8 @@ class CMinimap : public CIntObject
 protected:
 
 	CPicture *aiShield; //the graphic displayed during AI turn
-	CMinimapInstance * minimap;
+	CMinimapInstance * minimap; //shown level, nullptr during AI turn
+	std::vector<CMinimapInstance *> levels; //kept for whole game, created on first use
 	int level;
 
 	//to initialize colors
@@ -227,10 +232,13 @@ public:
 	const std::map<int, std::pair<SDL_Color, SDL_Color> > colors;
 
 	CMinimap(const Rect & position);
+	~CMinimap();
 
-	//should be called to invalidate whole map - different player or level
 	int3 translateMousePosition();
+	//shows current level, only tiles changed since it was shown last time are redrawn
 	void update();
+	//should be called to redraw whole map - e.g. different player
+	void invalidate();
 	void setLevel(int level);
 	void setAIRadar(bool on);
 
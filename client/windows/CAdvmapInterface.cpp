@@ -638,7 +638,6 @@ void CAdvMapInt::fshowOverview()
 void CAdvMapInt::fworldViewBack()
 {
 	changeMode(EAdvMapMode::NORMAL);
-	CGI->mh->discardWorldViewCache();
 
 	auto hero = curHero();
 	if (hero)
@@ -1373,6 +1372,7 @@ void CAdvMapInt::setPlayer(PlayerColor Player)
 	panelWorldView->setPlayerColor(player);
 	panelWorldView->recolorIcons(player, player.getNum() * 19);
 	graphics->blueToPlayersAdv(resdatabar.bg,player);
+	minimap.invalidate();
 }
 
 void CAdvMapInt::startTurn()
@@ -12,6 +12,8 @@
 #include "mapObjects/CObjectHandler.h"
 #include "StringConstants.h"
 #include "CStopWatch.h"
+#include "CThreadHelper.h"
+#include "CConfigHandler.h"
 #include "IHandlerBase.h"
 #include "spells/CSpellHandler.h"
 
@@ -55,17 +57,32 @@ void CIdentifierStorage::checkIdentifier(std::string & ID)
 }
 
 CIdentifierStorage::ObjectCallback::ObjectCallback(
-		std::string localScope, std::string remoteScope, std::string type,
+		TInterned localScope, TInterned remoteScope, TInterned type,
 		std::string name, const std::function<void(si32)> & callback,
 		bool optional):
 	localScope(localScope),
 	remoteScope(remoteScope),
 	type(type),
-	name(name),
+	name(std::move(name)),
 	callback(callback),
 	optional(optional)
 {}
 
+CIdentifierStorage::TInterned CIdentifierStorage::intern(const std::string & str)
+{
+	// only registration and requests intern strings, but those may still come from several threads
+	boost::unique_lock<boost::mutex> lock(internedStringsMutex);
+	return &*internedStrings.insert(str).first;
+}
+
+CIdentifierStorage::ObjectCallback CIdentifierStorage::makeRequest(
+		const std::string & localScope, const std::string & remoteScope,
+		const std::string & type, std::string name,
+		const std::function<void(si32)> & callback, bool optional)
+{
+	return ObjectCallback(intern(localScope), intern(remoteScope), intern(type), std::move(name), callback, optional);
+}
+
 static std::pair<std::string, std::string> splitString(std::string input, char separator)
 {
 	std::pair<std::string, std::string> ret;
@@ -86,13 +103,15 @@ static std::pair<std::string, std::string> splitString(std::string input, char s
 
 void CIdentifierStorage::requestIdentifier(ObjectCallback callback)
 {
-	checkIdentifier(callback.type);
+	std::string type = *callback.type;
+	checkIdentifier(type);
+	callback.type = intern(type);
 	checkIdentifier(callback.name);
 
-	assert(!callback.localScope.empty());
+	assert(!callback.localScope->empty());
 
 	if (state != FINISHED) // enqueue request if loading is still in progress
-		scheduledRequests.push_back(callback);
+		scheduledRequests.push_back(std::move(callback));
 	else // execute immediately for "late" requests
 		resolveIdentifier(callback);
 }
@@ -101,7 +120,7 @@ void CIdentifierStorage::requestIdentifier(std::string scope, std::string type,
 {
 	auto pair = splitString(name, ':'); // remoteScope:name
 
-	requestIdentifier(ObjectCallback(scope, pair.first, type, pair.second, callback, false));
+	requestIdentifier(makeRequest(scope, pair.first, type, pair.second, callback, false));
 }
 
 void CIdentifierStorage::requestIdentifier(std::string scope, std::string fullName, const std::function<void(si32)>& callback)
@@ -109,14 +128,14 @@ void CIdentifierStorage::requestIdentifier(std::string scope, std::string fullNa
 	auto scopeAndFullName = splitString(fullName, ':');
 	auto typeAndName = splitString(scopeAndFullName.second, '.');
 
-	requestIdentifier(ObjectCallback(scope, scopeAndFullName.first, typeAndName.first, typeAndName.second, callback, false));
+	requestIdentifier(makeRequest(scope, scopeAndFullName.first, typeAndName.first, typeAndName.second, callback, false));
 }
 
 void CIdentifierStorage::requestIdentifier(std::string type, const JsonNode & name, const std::function<void(si32)> & callback)
 {
 	auto pair = splitString(name.String(), ':'); // remoteScope:name
 
-	requestIdentifier(ObjectCallback(name.meta, pair.first, type, pair.second, callback, false));
+	requestIdentifier(makeRequest(name.meta, pair.first, type, pair.second, callback, false));
 }
 
 void CIdentifierStorage::requestIdentifier(const JsonNode & name, const std::function<void(si32)> & callback)
@@ -124,27 +143,27 @@ void CIdentifierStorage::requestIdentifier(const JsonNode & name, const std::fun
 	auto pair  = splitString(name.String(), ':'); // remoteScope:<type.name>
 	auto pair2 = splitString(pair.second,   '.'); // type.name
 
-	requestIdentifier(ObjectCallback(name.meta, pair.first, pair2.first, pair2.second, callback, false));
+	requestIdentifier(makeRequest(name.meta, pair.first, pair2.first, pair2.second, callback, false));
 }
 
 void CIdentifierStorage::tryRequestIdentifier(std::string scope, std::string type, std::string name, const std::function<void(si32)> & callback)
 {
 	auto pair = splitString(name, ':'); // remoteScope:name
 
-	requestIdentifier(ObjectCallback(scope, pair.first, type, pair.second, callback, true));
+	requestIdentifier(makeRequest(scope, pair.first, type, pair.second, callback, true));
 }
 
 void CIdentifierStorage::tryRequestIdentifier(std::string type, const JsonNode & name, const std::function<void(si32)> & callback)
 {
 	auto pair = splitString(name.String(), ':'); // remoteScope:name
 
-	requestIdentifier(ObjectCallback(name.meta, pair.first, type, pair.second, callback, true));
+	requestIdentifier(makeRequest(name.meta, pair.first, type, pair.second, callback, true));
 }
 
 boost::optional<si32> CIdentifierStorage::getIdentifier(std::string scope, std::string type, std::string name, bool silent)
 {
 	auto pair = splitString(name, ':'); // remoteScope:name
-	auto idList = getPossibleIdentifiers(ObjectCallback(scope, pair.first, type, pair.second, std::function<void(si32)>(), silent));
+	auto idList = getPossibleIdentifiers(scope, pair.first, type, pair.second);
 
 	if (idList.size() == 1)
 		return idList.front().id;
@@ -157,7 +176,7 @@ boost::optional<si32> CIdentifierStorage::getIdentifier(std::string scope, std::
 boost::optional<si32> CIdentifierStorage::getIdentifier(std::string type, const JsonNode & name, bool silent)
 {
 	auto pair = splitString(name.String(), ':'); // remoteScope:name
-	auto idList = getPossibleIdentifiers(ObjectCallback(name.meta, pair.first, type, pair.second, std::function<void(si32)>(), silent));
+	auto idList = getPossibleIdentifiers(name.meta, pair.first, type, pair.second);
 
 	if (idList.size() == 1)
 		return idList.front().id;
@@ -171,7 +190,7 @@ boost::optional<si32> CIdentifierStorage::getIdentifier(const JsonNode & name, b
 {
 	auto pair  = splitString(name.String(), ':'); // remoteScope:<type.name>
 	auto pair2 = splitString(pair.second,   '.'); // type.name
-	auto idList = getPossibleIdentifiers(ObjectCallback(name.meta, pair.first, pair2.first, pair2.second, std::function<void(si32)>(), silent));
+	auto idList = getPossibleIdentifiers(name.meta, pair.first, pair2.first, pair2.second);
 
 	if (idList.size() == 1)
 		return idList.front().id;
@@ -184,7 +203,7 @@ boost::optional<si32> CIdentifierStorage::getIdentifier(const JsonNode & name, b
 void CIdentifierStorage::registerObject(std::string scope, std::string type, std::string name, si32 identifier)
 {
 	ObjectData data;
-	data.scope = scope;
+	data.scope = intern(scope);
 	data.id = identifier;
 
 	std::string fullID = type + '.' + name;
@@ -193,17 +212,20 @@ void CIdentifierStorage::registerObject(std::string scope, std::string type, std
 	registeredObjects.insert(std::make_pair(fullID, data));
 }
 
-std::vector<CIdentifierStorage::ObjectData> CIdentifierStorage::getPossibleIdentifiers(const ObjectCallback & request)
+std::set<std::string> CIdentifierStorage::getAllowedScopeNames(const std::string & localScope, const std::string & remoteScope) const
 {
 	std::set<std::string> allowedScopes;
 
-	if (request.remoteScope.empty())
+	if (remoteScope.empty())
 	{
 		// normally ID's from all required mods, own mod and virtual "core" mod are allowed
-		if (request.localScope != "core" && request.localScope != "")
-			allowedScopes = VLC->modh->getModData(request.localScope).dependencies;
+		if (localScope != "core" && localScope != "")
+		{
+			for (auto & dependency : VLC->modh->getModData(localScope).dependencies)
+				allowedScopes.insert(dependency);
+		}
 
-		allowedScopes.insert(request.localScope);
+		allowedScopes.insert(localScope);
 		allowedScopes.insert("core");
 	}
 	else
@@ -213,20 +235,55 @@ std::vector<CIdentifierStorage::ObjectData> CIdentifierStorage::getPossibleIdent
 
 		//for map format support core mod has access to any mod
 		//TODO: better solution for access from map?
-		if(request.localScope == "core" || request.localScope == "")
+		if(localScope == "core" || localScope == "")
 		{
-			allowedScopes.insert(request.remoteScope);
+			allowedScopes.insert(remoteScope);
 		}
 		else
 		{
 			// allow only available to all core mod or dependencies
-			auto myDeps = VLC->modh->getModData(request.localScope).dependencies;
-			if (request.remoteScope == "core" || myDeps.count(request.remoteScope))
-				allowedScopes.insert(request.remoteScope);
+			const auto & myDeps = VLC->modh->getModData(localScope).dependencies;
+			if (remoteScope == "core" || myDeps.count(remoteScope))
+				allowedScopes.insert(remoteScope);
 		}
 	}
+	return allowedScopes;
+}
 
-	std::string fullID = request.type + '.' + request.name;
+std::set<CIdentifierStorage::TInterned> CIdentifierStorage::getAllowedScopes(TInterned localScope, TInterned remoteScope)
+{
+	std::set<TInterned> allowedScopes;
+	for (auto & scope : getAllowedScopeNames(*localScope, *remoteScope))
+		allowedScopes.insert(intern(scope));
+	return allowedScopes;
+}
+
+std::vector<CIdentifierStorage::ObjectData> CIdentifierStorage::getPossibleIdentifiers(const ObjectCallback & request)
+{
+	return getPossibleIdentifiers(request, getAllowedScopes(request.localScope, request.remoteScope));
+}
+
+std::vector<CIdentifierStorage::ObjectData> CIdentifierStorage::getPossibleIdentifiers(const std::string & localScope, const std::string & remoteScope,
+                                                                                     const std::string & type, const std::string & name) const
+{
+	std::vector<ObjectData> locatedIDs;
+
+	auto entries = registeredObjects.equal_range(type + '.' + name);
+	if (entries.first != entries.second)
+	{
+		auto allowedScopes = getAllowedScopeNames(localScope, remoteScope);
+		for (auto it = entries.first; it != entries.second; it++)
+		{
+			if (vstd::contains(allowedScopes, *it->second.scope))
+				locatedIDs.push_back(it->second);
+		}
+	}
+	return locatedIDs;
+}
+
+std::vector<CIdentifierStorage::ObjectData> CIdentifierStorage::getPossibleIdentifiers(const ObjectCallback & request, const std::set<TInterned> & allowedScopes) const
+{
+	std::string fullID = *request.type + '.' + request.name;
 
 	auto entries = registeredObjects.equal_range(fullID);
 	if (entries.first != entries.second)
@@ -247,7 +304,11 @@ std::vector<CIdentifierStorage::ObjectData> CIdentifierStorage::getPossibleIdent
 
 bool CIdentifierStorage::resolveIdentifier(const ObjectCallback & request)
 {
-	auto identifiers = getPossibleIdentifiers(request);
+	return resolveIdentifier(request, getPossibleIdentifiers(request));
+}
+
+bool CIdentifierStorage::resolveIdentifier(const ObjectCallback & request, const std::vector<ObjectData> & identifiers)
+{
 	if (identifiers.size() == 1) // normally resolved ID
 	{
 		request.callback(identifiers.front().id);
@@ -265,11 +326,11 @@ bool CIdentifierStorage::resolveIdentifier(const ObjectCallback & request)
 	else
 		logGlobal->errorStream() << "Ambiguous identifier request!";
 
-	 logGlobal->errorStream() << "Request for " << request.type << "." << request.name << " from mod " << request.localScope;
+	 logGlobal->errorStream() << "Request for " << *request.type << "." << request.name << " from mod " << *request.localScope;
 
 	for (auto id : identifiers)
 	{
-		logGlobal->errorStream() << "\tID is available in mod " << id.scope;
+		logGlobal->errorStream() << "\tID is available in mod " << *id.scope;
 	}
 	return false;
 }
@@ -279,17 +340,58 @@ void CIdentifierStorage::finalize()
 	state = FINALIZING;
 	bool errorsFound = false;
 
-	//Note: we may receive new requests during resolution phase -> end may change -> range for can't be used
-	for(auto it = scheduledRequests.begin(); it != scheduledRequests.end(); it++)
+	// allowed scopes depend only on requesting and requested mod - resolve all requests in one pass
+	// and calculate scopes only once for every such pair
+	std::map<std::pair<TInterned, TInterned>, std::set<TInterned> > scopesCache;
+
+	size_t resolvedCount = 0;
+	size_t batchesCount = 0;
+	boost::posix_time::time_duration scopesTime, lookupTime, callbacksTime;
+	auto now = []()
 	{
-		errorsFound |= !resolveIdentifier(*it);
+		return boost::posix_time::microsec_clock::universal_time();
+	};
+
+	//Note: we may receive new requests during resolution phase - they will be processed in next batch
+	while (!scheduledRequests.empty())
+	{
+		std::vector<ObjectCallback> batch;
+		batch.swap(scheduledRequests);
+
+		for(const ObjectCallback & request : batch)
+		{
+			auto start = now();
+			auto key = std::make_pair(request.localScope, request.remoteScope);
+			auto scopes = scopesCache.find(key);
+			if (scopes == scopesCache.end())
+				scopes = scopesCache.insert(std::make_pair(key, getAllowedScopes(request.localScope, request.remoteScope))).first;
+
+			auto scopesFound = now();
+			auto identifiers = getPossibleIdentifiers(request, scopes->second);
+
+			auto lookedUp = now();
+			errorsFound |= !resolveIdentifier(request, identifiers);
+
+			auto resolved = now();
+			scopesTime += scopesFound - start;
+			lookupTime += lookedUp - scopesFound;
+			callbacksTime += resolved - lookedUp;
+		}
+		resolvedCount += batch.size();
+		batchesCount++;
 	}
 
+	logGlobal->infoStream() << "\t\tResolved " << resolvedCount << " identifier requests in " << batchesCount << " batches, "
+							<< scopesCache.size() << " scope sets, " << registeredObjects.size() << " known objects";
+	logGlobal->infoStream() << "\t\tTime spent: scopes " << scopesTime.total_milliseconds() << " ms, lookups "
+							<< lookupTime.total_milliseconds() << " ms, callbacks " << callbacksTime.total_milliseconds() << " ms";
+
 	if (errorsFound)
 	{
-		for(auto object : registeredObjects)
+		std::multimap<std::string, ObjectData> sortedObjects(registeredObjects.begin(), registeredObjects.end());
+		for(auto object : sortedObjects)
 		{
-			logGlobal->traceStream() << object.second.scope << " : " << object.first << " -> " << object.second.id;
+			logGlobal->traceStream() << *object.second.scope << " : " << object.first << " -> " << object.second.id;
 		}
 		logGlobal->errorStream() << "All known identifiers were dumped into log file";
 	}
@@ -308,10 +410,8 @@ CContentHandler::ContentTypeHandler::ContentTypeHandler(IHandlerBase * handler,
 	}
 }
 
-bool CContentHandler::ContentTypeHandler::preloadModData(std::string modName, std::vector<std::string> fileList, bool validate)
+bool CContentHandler::ContentTypeHandler::preloadModData(std::string modName, JsonNode data)
 {
-	bool result;
-	JsonNode data = JsonUtils::assembleFromFiles(fileList, result);
 	data.setMeta(modName);
 
 	ModInfo & modInfo = modData[modName];
@@ -340,7 +440,7 @@ bool CContentHandler::ContentTypeHandler::preloadModData(std::string modName, st
 			JsonUtils::merge(remoteConf, entry.second);
 		}
 	}
-	return result;
+	return true;
 }
 
 bool CContentHandler::ContentTypeHandler::loadMod(std::string modName, bool validate)
@@ -348,41 +448,87 @@ bool CContentHandler::ContentTypeHandler::loadMod(std::string modName, bool vali
 	ModInfo & modInfo = modData[modName];
 	bool result = true;
 
-	auto performValidate = [&,this](JsonNode & data, const std::string & name){
-		handler->beforeValidate(data);
-		if (validate)
-			result &= JsonUtils::validate(data, "vcmi:" + objectName, name);
-	};
-
 	// apply patches
 	if (!modInfo.patches.isNull())
 		JsonUtils::merge(modInfo.modData, modInfo.patches);
 
+	// objects with index point to H3 data - merge them with original entry first
+	// original entry is consumed here so same data won't be used twice (same ID)
+	std::map<std::string, size_t> originalIndexes;
 	for(auto & entry : modInfo.modData.Struct())
 	{
-		const std::string & name = entry.first;
 		JsonNode & data = entry.second;
 
 		if (vstd::contains(data.Struct(), "index") && !data["index"].isNull())
 		{
-			// try to add H3 object data
 			size_t index = data["index"].Float();
 
 			if (originalData.size() > index)
 			{
-				JsonUtils::merge(originalData[index], data);
-
-				performValidate(originalData[index],name);
-				handler->loadObject(modName, name, originalData[index], index);
+				JsonNode merged;
+				merged.swap(originalData[index]);
+				JsonUtils::merge(merged, data);
+				data.swap(merged);
+				originalIndexes[entry.first] = index;
+			}
+		}
+	}
 
-				originalData[index].clear(); // do not use same data twice (same ID)
+	// validation does not depend on other objects - check all of them in parallel
+	std::vector<Task> tasks;
+	std::vector<ui8> validated(modInfo.modData.Struct().size(), true);
+	std::vector<std::exception_ptr> errors(validated.size());
+	for(auto & entry : modInfo.modData.Struct())
+	{
+		const std::string * name = &entry.first;
+		JsonNode * data = &entry.second;
+		ui8 * isValid = &validated[tasks.size()];
+		std::exception_ptr * error = &errors[tasks.size()];
 
-				continue;
+		tasks.push_back([=]()
+		{
+			try
+			{
+				handler->beforeValidate(*data);
+				if (validate)
+					*isValid = JsonUtils::validate(*data, "vcmi:" + objectName, *name);
 			}
-		}
-		// normal new object or one with index bigger that data size
-		performValidate(data,name);
-		handler->loadObject(modName, name, data);
+			catch(...)
+			{
+				*error = std::current_exception();
+			}
+		});
+	}
+
+	if (validate && tasks.size() > 1)
+	{
+		CThreadHelper helper(&tasks, std::min<ui32>(tasks.size(), std::max((ui32)1, boost::thread::hardware_concurrency())));
+		helper.run();
+	}
+	else
+	{
+		for(auto & task : tasks)
+			task();
+	}
+
+	for(auto & error : errors)
+	{
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	for(ui8 isValid : validated)
+		result &= isValid;
+
+	// registration of objects must happen in fixed order to keep all ID's identical
+	for(auto & entry : modInfo.modData.Struct())
+	{
+		auto index = originalIndexes.find(entry.first);
+
+		if (index != originalIndexes.end())
+			handler->loadObject(modName, entry.first, entry.second, index->second);
+		else
+			handler->loadObject(modName, entry.first, entry.second);
 	}
 	return result;
 }
@@ -392,26 +538,110 @@ void CContentHandler::ContentTypeHandler::afterLoadFinalization()
 	handler->afterLoadFinalization();
 }
 
-CContentHandler::CContentHandler()
+CContentHandler::CContentHandler(bool uncachedOnly)
 {
- 	handlers.insert(std::make_pair("heroClasses", ContentTypeHandler(&VLC->heroh->classes, "heroClass")));
-	handlers.insert(std::make_pair("artifacts", ContentTypeHandler(VLC->arth, "artifact")));
-	handlers.insert(std::make_pair("creatures", ContentTypeHandler(VLC->creh, "creature")));
-	handlers.insert(std::make_pair("factions", ContentTypeHandler(VLC->townh, "faction")));
-	handlers.insert(std::make_pair("objects", ContentTypeHandler(VLC->objtypeh, "object")));
-	handlers.insert(std::make_pair("heroes", ContentTypeHandler(VLC->heroh, "hero")));
-	handlers.insert(std::make_pair("spells", ContentTypeHandler(VLC->spellh, "spell")));
+	if (!uncachedOnly)
+	{
+		handlers.insert(std::make_pair("heroClasses", ContentTypeHandler(&VLC->heroh->classes, "heroClass")));
+		handlers.insert(std::make_pair("artifacts", ContentTypeHandler(VLC->arth, "artifact")));
+		handlers.insert(std::make_pair("creatures", ContentTypeHandler(VLC->creh, "creature")));
+		handlers.insert(std::make_pair("factions", ContentTypeHandler(VLC->townh, "faction")));
+		handlers.insert(std::make_pair("objects", ContentTypeHandler(VLC->objtypeh, "object")));
+		handlers.insert(std::make_pair("heroes", ContentTypeHandler(VLC->heroh, "hero")));
+		handlers.insert(std::make_pair("spells", ContentTypeHandler(VLC->spellh, "spell")));
+	}
+	// templates are not serializable and can't be stored in content cache
 	handlers.insert(std::make_pair("templates", ContentTypeHandler((IHandlerBase *)VLC->tplh, "template")));
 
 	//TODO: any other types of moddables?
 }
 
+CContentHandler::ParsedFile::ParsedFile():
+	isValid(true),
+	references(0)
+{
+}
+
+void CContentHandler::parseFiles(const std::vector<const CModInfo *> & mods)
+{
+	for(const CModInfo * mod : mods)
+	{
+		for(auto & handler : handlers)
+		{
+			for(const std::string & file : mod->config[handler.first].convertTo<std::vector<std::string> >())
+				parsedFiles[file].references++;
+		}
+	}
+
+	// parsing is independent from any handlers so all files can be processed at once
+	std::vector<Task> tasks;
+	for(auto & file : parsedFiles)
+	{
+		const std::string * name = &file.first;
+		ParsedFile * parsed = &file.second;
+
+		tasks.push_back([=]()
+		{
+			try
+			{
+				parsed->data = JsonNode(ResourceID(*name, EResType::TEXT), parsed->isValid);
+			}
+			catch(...)
+			{
+				parsed->error = std::current_exception();
+			}
+		});
+	}
+
+	CThreadHelper helper(&tasks, std::max((ui32)1, boost::thread::hardware_concurrency()));
+	helper.run();
+}
+
+JsonNode CContentHandler::assembleFromFiles(const std::vector<std::string> & files, bool & isValid)
+{
+	isValid = true;
+	JsonNode result;
+
+	for(const std::string & file : files)
+	{
+		auto it = parsedFiles.find(file);
+		if (it == parsedFiles.end())
+		{
+			bool isValidFile;
+			JsonNode section(ResourceID(file, EResType::TEXT), isValidFile);
+			JsonUtils::merge(result, section);
+			isValid &= isValidFile;
+			continue;
+		}
+
+		ParsedFile & parsed = it->second;
+		if (parsed.error)
+			std::rethrow_exception(parsed.error);
+
+		isValid &= parsed.isValid;
+
+		// last user of this file can take its data, otherwise keep it intact for others
+		if (--parsed.references == 0)
+		{
+			JsonUtils::merge(result, parsed.data);
+			parsedFiles.erase(it);
+		}
+		else
+			JsonUtils::mergeCopy(result, parsed.data);
+	}
+	return result;
+}
+
 bool CContentHandler::preloadModData(std::string modName, JsonNode modConfig, bool validate)
 {
 	bool result = true;
 	for(auto & handler : handlers)
 	{
-		result &= handler.second.preloadModData(modName, modConfig[handler.first].convertTo<std::vector<std::string> >(), validate);
+		bool isValid;
+		JsonNode data = assembleFromFiles(modConfig[handler.first].convertTo<std::vector<std::string> >(), isValid);
+
+		result &= isValid;
+		result &= handler.second.preloadModData(modName, data);
 	}
 	return result;
 }
@@ -894,19 +1124,63 @@ void CModHandler::initializeConfig()
 	loadConfigFromFile("defaultMods.json");
 }
 
-void CModHandler::load()
+void CModHandler::updateChecksums()
 {
-	CStopWatch totalTime, timer;
+	CStopWatch timer;
 
-	CContentHandler content;
-	logGlobal->infoStream() << "\tInitializing content handler: " << timer.getDiff() << " ms";
+	std::vector<Task> checksumTasks;
+	std::vector<ui32> checksums(activeMods.size());
+	for(size_t i = 0; i < activeMods.size(); i++)
+	{
+		const TModID * modName = &activeMods[i];
+		ui32 * checksum = &checksums[i];
+
+		checksumTasks.push_back([=]()
+		{
+			logGlobal->traceStream() << "Generating checksum for " << *modName;
+			*checksum = calculateModChecksum(*modName, CResourceHandler::get(*modName));
+		});
+	}
+	CThreadHelper checksumHelper(&checksumTasks, std::max((ui32)1, boost::thread::hardware_concurrency()));
+	checksumHelper.run();
 
+	for(size_t i = 0; i < activeMods.size(); i++)
+		allMods[activeMods[i]].updateChecksum(checksums[i]);
+	logGlobal->infoStream() << "\tCalculating mod checksums: " << timer.getDiff() << " ms";
+}
+
+ui32 CModHandler::getContentChecksum() const
+{
+	boost::crc_32_type contentChecksum;
+	contentChecksum.process_bytes(reinterpret_cast<const void *>(&coreMod.checksum), sizeof(coreMod.checksum));
+
+	// order of mods affects loaded data (e.g. assigned ID's)
 	for(const TModID & modName : activeMods)
 	{
-		logGlobal->traceStream() << "Generating checksum for " << modName;
-		allMods[modName].updateChecksum(calculateModChecksum(modName, CResourceHandler::get(modName)));
+		const CModInfo & mod = allMods.at(modName);
+		contentChecksum.process_bytes(reinterpret_cast<const void *>(modName.data()), modName.size());
+		contentChecksum.process_bytes(reinterpret_cast<const void *>(&mod.checksum), sizeof(mod.checksum));
 	}
 
+	// H3 text data is decoded using selected encoding
+	const std::string & encoding = ::settings["general"]["encoding"].String();
+	contentChecksum.process_bytes(reinterpret_cast<const void *>(encoding.data()), encoding.size());
+
+	return contentChecksum.checksum();
+}
+
+void CModHandler::loadContent(CContentHandler & content)
+{
+	CStopWatch timer;
+
+	std::vector<const CModInfo *> loadedMods;
+	loadedMods.push_back(&coreMod);
+	for(const TModID & modName : activeMods)
+		loadedMods.push_back(&allMods[modName]);
+
+	content.parseFiles(loadedMods);
+	logGlobal->infoStream() << "\tReading mod files: " << timer.getDiff() << " ms";
+
 	// first - load virtual "core" mod that contains all data
 	// TODO? move all data into real mods? RoE, AB, SoD, WoG
 	content.preloadData(coreMod);
@@ -919,6 +1193,17 @@ void CModHandler::load()
 		content.load(allMods[modName]);
 
 	logGlobal->infoStream() << "\tLoading mod data: " << timer.getDiff() << "ms";
+}
+
+void CModHandler::load()
+{
+	CStopWatch totalTime, timer;
+
+	CContentHandler content;
+	logGlobal->infoStream() << "\tInitializing content handler: " << timer.getDiff() << " ms";
+
+	loadContent(content);
+	timer.update();
 
 	VLC->creh->loadCrExpBon();
 	VLC->creh->buildBonusTreeForTiers(); //do that after all new creatures are loaded
@@ -931,6 +1216,17 @@ void CModHandler::load()
 	logGlobal->infoStream() << "\tAll game content loaded in " << totalTime.getDiff() << " ms";
 }
 
+void CModHandler::loadUncachedContent()
+{
+	CStopWatch totalTime;
+
+	CContentHandler content(true);
+	loadContent(content);
+	content.afterLoadFinalization();
+
+	logGlobal->infoStream() << "\tContent missing in cache loaded in " << totalTime.getDiff() << " ms";
+}
+
 void CModHandler::afterLoad()
 {
 	JsonNode modSettings;
@@ -32,17 +32,20 @@ class CIdentifierStorage
 		FINISHED
 	};
 
+	/// interned string, equal strings are stored only once and can be compared by pointer
+	typedef const std::string * TInterned;
+
 	struct ObjectCallback // entry created on ID request
 	{
-		std::string localScope;  /// scope from which this ID was requested
-		std::string remoteScope; /// scope in which this object must be found
-		std::string type;        /// type, e.g. creature, faction, hero, etc
-		std::string name;        /// string ID
+		TInterned localScope;  /// scope from which this ID was requested
+		TInterned remoteScope; /// scope in which this object must be found
+		TInterned type;        /// type, e.g. creature, faction, hero, etc
+		std::string name;      /// string ID
 		std::function<void(si32)> callback;
 		bool optional;
 
-		ObjectCallback(std::string localScope, std::string remoteScope,
-		               std::string type, std::string name,
+		ObjectCallback(TInterned localScope, TInterned remoteScope,
+		               TInterned type, std::string name,
 		               const std::function<void(si32)> & callback,
 		               bool optional);
 	};
@@ -50,8 +53,14 @@ class CIdentifierStorage
 	struct ObjectData // entry created on ID registration
 	{
 		si32 id;
-		std::string scope; /// scope in which this ID located
+		TInterned scope; /// scope in which this ID located
+	};
 
+	/// form of ObjectData stored in saves
+	struct SavedObjectData
+	{
+		si32 id;
+		std::string scope;
 
 		template <typename Handler> void serialize(Handler &h, const int version)
 		{
@@ -59,7 +68,13 @@ class CIdentifierStorage
 		}
 	};
 
-	std::multimap<std::string, ObjectData > registeredObjects;
+	/// scopes and types are shared by most requests and objects - each of them is stored only once
+	/// names are nearly unique, so they are kept as plain strings
+	std::unordered_set<std::string> internedStrings;
+	boost::mutex internedStringsMutex;
+
+	/// all registered objects, indexed by full ID in form <type>.<name>
+	std::unordered_multimap<std::string, ObjectData > registeredObjects;
 	std::vector<ObjectCallback> scheduledRequests;
 
 	ELoadingState state;
@@ -67,9 +82,24 @@ class CIdentifierStorage
 	/// Check if identifier can be valid (camelCase, point as separator)
 	void checkIdentifier(std::string & ID);
 
+	TInterned intern(const std::string & str);
+
+	ObjectCallback makeRequest(const std::string & localScope, const std::string & remoteScope,
+	                           const std::string & type, std::string name,
+	                           const std::function<void(si32)> & callback, bool optional);
+
+	/// returns list of mods in which object requested from localScope may be located
+	std::set<std::string> getAllowedScopeNames(const std::string & localScope, const std::string & remoteScope) const;
+	std::set<TInterned> getAllowedScopes(TInterned localScope, TInterned remoteScope);
+
 	void requestIdentifier(ObjectCallback callback);
 	bool resolveIdentifier(const ObjectCallback & callback);
+	bool resolveIdentifier(const ObjectCallback & callback, const std::vector<ObjectData> & identifiers);
 	std::vector<ObjectData> getPossibleIdentifiers(const ObjectCallback & callback);
+	std::vector<ObjectData> getPossibleIdentifiers(const ObjectCallback & callback, const std::set<TInterned> & allowedScopes) const;
+	/// immediate lookup, scopes are compared by value so string pool is not touched
+	std::vector<ObjectData> getPossibleIdentifiers(const std::string & localScope, const std::string & remoteScope,
+	                                               const std::string & type, const std::string & name) const;
 public:
 	CIdentifierStorage();
 	virtual ~CIdentifierStorage();
@@ -98,7 +128,22 @@ public:
 
 	template <typename Handler> void serialize(Handler &h, const int version)
 	{
-		h & registeredObjects & state;
+		// saves use ordered map with plain strings, hashed one is only used at runtime
+		std::multimap<std::string, SavedObjectData> objects;
+		if (h.saving)
+		{
+			for (auto & object : registeredObjects)
+				objects.insert(std::make_pair(object.first, SavedObjectData{object.second.id, *object.second.scope}));
+		}
+
+		h & objects & state;
+
+		if (!h.saving)
+		{
+			registeredObjects.clear();
+			for (auto & object : objects)
+				registeredObjects.insert(std::make_pair(object.first, ObjectData{object.second.id, intern(object.second.scope)}));
+		}
 	}
 };
 
@@ -130,11 +175,29 @@ class CContentHandler
 
 		/// local version of methods in ContentHandler
 		/// returns true if loading was successful
-		bool preloadModData(std::string modName, std::vector<std::string> fileList, bool validate);
+		bool preloadModData(std::string modName, JsonNode data);
 		bool loadMod(std::string modName, bool validate);
 		void afterLoadFinalization();
 	};
 
+	/// json file that was parsed ahead of preloading by parseFiles()
+	struct ParsedFile
+	{
+		JsonNode data;
+		bool isValid;
+		/// exception thrown while parsing, rethrown once file is actually used
+		std::exception_ptr error;
+		/// number of content lists that still need this file
+		size_t references;
+
+		ParsedFile();
+	};
+
+	std::map<std::string, ParsedFile> parsedFiles;
+
+	/// merges all files from list into one node, using data from parsedFiles if available
+	JsonNode assembleFromFiles(const std::vector<std::string> & files, bool & isValid);
+
 	/// preloads all data from fileList as data from modName.
 	bool preloadModData(std::string modName, JsonNode modConfig, bool validate);
 
@@ -144,7 +207,12 @@ class CContentHandler
 	std::map<std::string, ContentTypeHandler> handlers;
 public:
 	/// fully initialize object. Will cause reading of H3 config files
-	CContentHandler();
+	/// if uncachedOnly is set only content that can't be stored in content cache will be loaded
+	CContentHandler(bool uncachedOnly = false);
+
+	/// parses all content files of selected mods using all available threads
+	/// does not modify any handlers, results are used by preloadData
+	void parseFiles(const std::vector<const CModInfo *> & mods);
 
 	/// preloads all data from fileList as data from modName.
 	void preloadData(CModInfo & mod);
@@ -232,6 +300,9 @@ class DLL_LINKAGE CModHandler
 
 	std::vector<std::string> getModList(std::string path);
 	void loadMods(std::string path, std::string namePrefix, const JsonNode & modSettings, bool enableMods);
+
+	/// parses, preloads and loads data of all active mods into content handler
+	void loadContent(CContentHandler & content);
 public:
 
 	CIdentifierStorage identifiers;
@@ -247,8 +318,15 @@ public:
 	std::vector<std::string> getAllMods();
 	std::vector<std::string> getActiveMods();
 
+	/// calculates checksums of all active mods, should be called before load()
+	void updateChecksums();
+	/// checksum of all loaded game content. Changed if any of active mods or their load order was changed
+	ui32 getContentChecksum() const;
+
 	/// load content from all available mods
 	void load();
+	/// load content that is not stored in content cache, used instead of load() if cached content was loaded
+	void loadUncachedContent();
 	void afterLoad();
 
 	struct DLL_LINKAGE hardcodedFeatures
@@ -82,7 +82,8 @@ const std::map<std::string, TPropagatorPtr> bonusPropagatorMap =
 
 #define BONUS_LOG_LINE(x) logBonus->traceStream() << x
 
-int CBonusSystemNode::treeChanged = 1;
+std::atomic<int> CBonusSystemNode::treeChanged(1);
+boost::recursive_mutex CBonusSystemNode::treeMutex;
 const bool CBonusSystemNode::cachingEnabled = true;
 
 BonusList::BonusList(bool BelongsToTree /* =false */) : belongsToTree(BelongsToTree)
@@ -551,45 +552,58 @@ const TBonusListPtr CBonusSystemNode::getAllBonuses(const CSelector &selector, c
 	bool limitOnUs = (!root || root == this); //caching won't work when we want to limit bonuses against an external node
 	if (CBonusSystemNode::cachingEnabled && limitOnUs)
 	{
-		// Exclusive access for one thread
+		// Exclusive access for one thread, but only while cache is accessed - selection below
+		// works on snapshot of cached bonuses, so several threads may query bonuses at once
 		static boost::mutex m;
-		boost::mutex::scoped_lock lock(m);
-
-		// If the bonus system tree changes(state of a single node or the relations to each other) then
-		// cache all bonus objects. Selector objects doesn't matter.
-		if (cachedLast != treeChanged)
+		std::shared_ptr<const BonusList> bonusesSnapshot;
+		int snapshotTreeChanged; // tree state the snapshot was taken from
 		{
-			cachedBonuses.clear();
-			cachedRequests.clear();
+			boost::mutex::scoped_lock lock(m);
 
-			BonusList allBonuses;
-			getAllBonusesRec(allBonuses);
-			allBonuses.eliminateDuplicates();
-			limitBonuses(allBonuses, cachedBonuses);
+			// If the bonus system tree changes(state of a single node or the relations to each other) then
+			// cache all bonus objects. Selector objects doesn't matter.
+			const int currentTreeChanged = treeChanged;
+			if (cachedLast != currentTreeChanged)
+			{
+				cachedRequests.clear();
 
-			cachedLast = treeChanged;
-		}
+				BonusList allBonuses;
+				getAllBonusesRec(allBonuses);
+				allBonuses.eliminateDuplicates();
+				auto limitedBonuses = std::make_shared<BonusList>();
+				limitBonuses(allBonuses, *limitedBonuses);
+				cachedBonuses = limitedBonuses;
 
-		// If a bonus system request comes with a caching string then look up in the map if there are any
-		// pre-calculated bonus results. Limiters can't be cached so they have to be calculated.
-		if (cachingStr != "")
-		{
-			auto it = cachedRequests.find(cachingStr);
-			if(it != cachedRequests.end())
+				cachedLast = currentTreeChanged;
+			}
+
+			// If a bonus system request comes with a caching string then look up in the map if there are any
+			// pre-calculated bonus results. Limiters can't be cached so they have to be calculated.
+			if (cachingStr != "")
 			{
-				//Cached list contains bonuses for our query with applied limiters
-				return it->second;
+				auto it = cachedRequests.find(cachingStr);
+				if(it != cachedRequests.end())
+				{
+					//Cached list contains bonuses for our query with applied limiters
+					return it->second;
+				}
 			}
+			bonusesSnapshot = cachedBonuses;
+			snapshotTreeChanged = cachedLast;
 		}
 
 		//We still don't have the bonuses (didn't returned them from cache)
 		//Perform bonus selection
 		auto ret = std::make_shared<BonusList>();
-		cachedBonuses.getBonuses(*ret, selector, limit);
+		bonusesSnapshot->getBonuses(*ret, selector, limit);
 
-		// Save the results in the cache
+		// Save the results in the cache, unless another thread has rebuilt it for changed tree meanwhile
 		if(cachingStr != "")
-			cachedRequests[cachingStr] = ret;
+		{
+			boost::mutex::scoped_lock lock(m);
+			if (cachedLast == snapshotTreeChanged)
+				cachedRequests[cachingStr] = ret;
+		}
 
 		return ret;
 	}
@@ -682,6 +696,7 @@ CBonusSystemNode::~CBonusSystemNode()
 
 void CBonusSystemNode::attachTo(CBonusSystemNode *parent)
 {
+	TLockGuardRec lock(treeMutex);
 	assert(!vstd::contains(parents, parent));
 	parents.push_back(parent);
 
@@ -696,6 +711,7 @@ void CBonusSystemNode::attachTo(CBonusSystemNode *parent)
 
 void CBonusSystemNode::detachFrom(CBonusSystemNode *parent)
 {
+	TLockGuardRec lock(treeMutex);
 	assert(vstd::contains(parents, parent));
 
 	if(parent->actsAsBonusSourceOnly())
@@ -601,9 +601,10 @@ private:
 	std::string description;
 
 	static const bool cachingEnabled;
-	mutable BonusList cachedBonuses;
+	mutable std::shared_ptr<const BonusList> cachedBonuses; //replaced, not modified, so readers may use it without lock
 	mutable int cachedLast;
-	static int treeChanged;
+	static std::atomic<int> treeChanged;
+	static boost::recursive_mutex treeMutex; //serializes attaching and detaching, handler nodes may get children from several threads
 
 	// Setting a value to cachingStr before getting any bonuses caches the result for later requests.
 	// This string needs to be unique, that's why it has to be setted in the following manner:
@@ -183,6 +183,7 @@ void CPrivilagedInfoCallback::saveCommonState(Saver &out) const
 	out.serializer & static_cast<CMapHeader&>(*gs->map);
 	logGlobal->infoStream() << "\tSaving options";
 	out.serializer & gs->scenarioOps;
+	out.finishChunk(); //header and options are read alone by savegame selection
 	logGlobal->infoStream() << "\tSaving handlers";
 	out.serializer & *VLC;
 	logGlobal->infoStream() << "\tSaving gamestate";
@@ -193,6 +194,7 @@ void CPrivilagedInfoCallback::saveCommonState(Saver &out) const
 template DLL_LINKAGE void CPrivilagedInfoCallback::loadCommonState<CLoadIntegrityValidator>(CLoadIntegrityValidator&);
 template DLL_LINKAGE void CPrivilagedInfoCallback::loadCommonState<CLoadFile>(CLoadFile&);
 template DLL_LINKAGE void CPrivilagedInfoCallback::saveCommonState<CSaveFile>(CSaveFile&) const;
+template DLL_LINKAGE void CPrivilagedInfoCallback::saveCommonState<CBackgroundSaveFile>(CBackgroundSaveFile&) const;
 
 TerrainTile * CNonConstInfoCallback::getTile( int3 pos )
 {
@@ -305,7 +305,7 @@ bool JsonParser::extractString(JsonNode &node)
 		return false;
 
 	node.setType(JsonNode::DATA_STRING);
-	node.String() = str;
+	node.String().swap(str);
 	return true;
 }
 
@@ -365,6 +365,8 @@ bool JsonParser::extractStruct(JsonNode &node)
 		return true;
 	}
 
+	JsonMap & members = node.Struct();
+
 	while (true)
 	{
 		if (!extractWhitespace())
@@ -374,13 +376,17 @@ bool JsonParser::extractStruct(JsonNode &node)
 		if (!extractString(key))
 			return false;
 
-		if (node.Struct().find(key) != node.Struct().end())
+		// single lookup for both duplicate check and insertion
+		auto member = members.lower_bound(key);
+		if (member != members.end() && member->first == key)
 			error("Dublicated element encountered!", true);
+		else
+			member = members.insert(member, std::make_pair(std::move(key), JsonNode()));
 
 		if (!extractSeparator())
 			return false;
 
-		if (!extractElement(node.Struct()[key], '}'))
+		if (!extractElement(member->second, '}'))
 			return false;
 
 		if (input[pos] == '}')
@@ -406,13 +412,22 @@ bool JsonParser::extractArray(JsonNode &node)
 		return true;
 	}
 
+	// Resizing vector of JsonNode's copies every already parsed subtree
+	// Collect items in deque first and swap() all of them into vector at the end
+	std::deque<JsonNode> items;
+	auto onExit = vstd::makeScopeGuard([&]()
+	{
+		JsonVector & vector = node.Vector();
+		vector.resize(items.size());
+		for (size_t i = 0; i < items.size(); i++)
+			vector[i].swap(items[i]);
+	});
+
 	while (true)
 	{
-		//NOTE: currently 50% of time is this vector resizing.
-		//May be useful to use list during parsing and then swap() all items to vector
-		node.Vector().resize(node.Vector().size()+1);
+		items.emplace_back();
 
-		if (!extractElement(node.Vector().back(), ']'))
+		if (!extractElement(items.back(), ']'))
 			return false;
 
 		if (input[pos] == ']')
@@ -631,7 +646,7 @@ namespace
 
 		std::string formatCheck(Validation::ValidationData & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
 		{
-			auto formats = Validation::getKnownFormats();
+			const auto & formats = Validation::getKnownFormats();
 			std::string errors;
 			auto checker = formats.find(schema.String());
 			if (checker != formats.end())
@@ -707,10 +722,9 @@ namespace
 
 	namespace Vector
 	{
-		std::string itemEntryCheck(Validation::ValidationData & validator, const JsonVector items, const JsonNode & schema, size_t index)
+		std::string itemEntryCheck(Validation::ValidationData & validator, const JsonVector & items, const JsonNode & schema, size_t index)
 		{
-			validator.currentPath.push_back(JsonNode());
-			validator.currentPath.back().Float() = index;
+			validator.currentPath.push_back(index);
 			auto onExit = vstd::makeScopeGuard([&]
 			{
 				validator.currentPath.pop_back();
@@ -839,8 +853,7 @@ namespace
 				{
 					if (deps.second.getType() == JsonNode::DATA_VECTOR)
 					{
-						JsonVector depList = deps.second.Vector();
-						for(auto & depEntry : depList)
+						for(auto & depEntry : deps.second.Vector())
 						{
 							if (data[depEntry.String()].isNull())
 								errors += validator.makeErrorMessage("Property " + depEntry.String() + " required for " + deps.first + " is missing");
@@ -856,10 +869,9 @@ namespace
 			return errors;
 		}
 
-		std::string propertyEntryCheck(Validation::ValidationData & validator, const JsonNode &node, const JsonNode & schema, std::string nodeName)
+		std::string propertyEntryCheck(Validation::ValidationData & validator, const JsonNode &node, const JsonNode & schema, const std::string & nodeName)
 		{
-			validator.currentPath.push_back(JsonNode());
-			validator.currentPath.back().String() = nodeName;
+			validator.currentPath.push_back(&nodeName);
 			auto onExit = vstd::makeScopeGuard([&]
 			{
 				validator.currentPath.pop_back();
@@ -1072,13 +1084,13 @@ namespace Validation
 		errors += "At ";
 		if (!currentPath.empty())
 		{
-			for(const JsonNode &path : currentPath)
+			for(auto & path : currentPath)
 			{
 				errors += "/";
-				if (path.getType() == JsonNode::DATA_STRING)
-					errors += path.String();
+				if (auto name = boost::get<const std::string *>(&path))
+					errors += **name;
 				else
-					errors += boost::lexical_cast<std::string>(static_cast<unsigned>(path.Float()));
+					errors += boost::lexical_cast<std::string>(boost::get<size_t>(path));
 			}
 		}
 		else
@@ -1105,17 +1117,44 @@ namespace Validation
 
 	std::string check(const JsonNode & schema, const JsonNode & data, ValidationData & validator)
 	{
-		const TValidatorMap & knownFields = getKnownFieldsFor(data.getType());
 		std::string errors;
-		for(auto & entry : schema.Struct())
+		for(auto & entry : getValidationPlan(schema, data.getType()))
+			errors += (*entry.first)(validator, schema, *entry.second, data);
+		return errors;
+	}
+
+	const TValidationPlan & getValidationPlan(const JsonNode & schema, JsonNode::JsonType type)
+	{
+		typedef std::array<TValidationPlan, JsonNode::DATA_STRUCT + 1> TSchemaPlans;
+
+		// schemas are never unloaded so address of node can be used as key
+		static std::unordered_map<const JsonNode *, TSchemaPlans> compiledSchemas;
+		static boost::shared_mutex compiledSchemasMutex;
+
 		{
-			auto checker = knownFields.find(entry.first);
-			if (checker != knownFields.end())
-				errors += checker->second(validator, schema, entry.second, data);
-			//else
-			//	errors += validator.makeErrorMessage("Unknown entry in schema " + entry.first);
+			boost::shared_lock<boost::shared_mutex> lock(compiledSchemasMutex);
+			auto it = compiledSchemas.find(&schema);
+			if (it != compiledSchemas.end())
+				return it->second[type];
 		}
-		return errors;
+
+		TSchemaPlans plans;
+		for (size_t i = 0; i < plans.size(); i++)
+		{
+			const TValidatorMap & knownFields = getKnownFieldsFor(static_cast<JsonNode::JsonType>(i));
+			for(auto & entry : schema.Struct())
+			{
+				auto checker = knownFields.find(entry.first);
+				if (checker != knownFields.end())
+					plans[i].push_back(std::make_pair(&checker->second, &entry.second));
+				//else
+				//	errors += validator.makeErrorMessage("Unknown entry in schema " + entry.first);
+			}
+		}
+
+		boost::unique_lock<boost::shared_mutex> lock(compiledSchemasMutex);
+		// another thread may have compiled same schema in meantime - in this case its version will be used
+		return compiledSchemas.insert(std::make_pair(&schema, std::move(plans))).first->second[type];
 	}
 
 	const TValidatorMap & getKnownFieldsFor(JsonNode::JsonType type)
@@ -100,8 +100,8 @@ namespace Validation
 	struct ValidationData
 	{
 		/// path from root node to current one.
-		/// JsonNode is used as variant - either string (name of node) or as float (index in list)
-		std::vector<JsonNode> currentPath;
+		/// Either name of node (points to key in validated data) or index in list
+		std::vector<boost::variant<const std::string *, size_t> > currentPath;
 
 		/// Stack of used schemas. Last schema is the one used currently.
 		/// May contain multiple items in case if remote references were found
@@ -115,9 +115,14 @@ namespace Validation
 	typedef std::unordered_map<std::string, TFormatValidator> TFormatMap;
 	typedef std::function<std::string(ValidationData &, const JsonNode &, const JsonNode &, const JsonNode &)> TFieldValidator;
 	typedef std::unordered_map<std::string, TFieldValidator> TValidatorMap;
+	/// all known fields of one schema node matched with their validators, in order of appearance in schema
+	typedef std::vector<std::pair<const TFieldValidator *, const JsonNode *> > TValidationPlan;
 
 	/// map of known fields in schema
 	const TValidatorMap & getKnownFieldsFor(JsonNode::JsonType type);
+	/// validators for specific schema node, built once on first use
+	/// schema must be part of one of loaded schemas (or any other node that is never destroyed)
+	const TValidationPlan & getValidationPlan(const JsonNode & schema, JsonNode::JsonType type);
 	const TFormatMap & getKnownFormats();
 
 	std::string check(std::string schemaName, const JsonNode & data);
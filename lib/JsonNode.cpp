@@ -91,12 +91,18 @@ JsonNode::JsonNode(const JsonNode &copy):
 	}
 }
 
+JsonNode::JsonNode(JsonNode &&other) BOOST_NOEXCEPT:
+	type(DATA_NULL)
+{
+	swap(other);
+}
+
 JsonNode::~JsonNode()
 {
 	setType(DATA_NULL);
 }
 
-void JsonNode::swap(JsonNode &b)
+void JsonNode::swap(JsonNode &b) BOOST_NOEXCEPT
 {
 	using std::swap;
 	swap(meta, b.meta);
@@ -104,7 +110,14 @@ void JsonNode::swap(JsonNode &b)
 	swap(type, b.type);
 }
 
-JsonNode & JsonNode::operator =(JsonNode node)
+JsonNode & JsonNode::operator =(const JsonNode &node)
+{
+	JsonNode copy(node);
+	swap(copy);
+	return *this;
+}
+
+JsonNode & JsonNode::operator =(JsonNode &&node) BOOST_NOEXCEPT
 {
 	swap(node);
 	return *this;
@@ -670,8 +683,8 @@ bool JsonUtils::validate(const JsonNode &node, std::string schemaName, std::stri
 	std::string log = Validation::check(schemaName, node);
 	if (!log.empty())
 	{
-		logGlobal->warnStream() << "Data in " << dataName << " is invalid!";
-		logGlobal->warnStream() << log;
+		// single message - validation may run from several threads at once
+		logGlobal->warnStream() << "Data in " << dataName << " is invalid!\n" << log;
 	}
 	return log.empty();
 }
@@ -680,6 +693,9 @@ const JsonNode & getSchemaByName(std::string name)
 {
 	// cached schemas to avoid loading json data multiple times
 	static std::map<std::string, JsonNode> loadedSchemas;
+	static boost::mutex loadedSchemasMutex;
+
+	boost::unique_lock<boost::mutex> lock(loadedSchemasMutex);
 
 	if (vstd::contains(loadedSchemas, name))
 		return loadedSchemas[name];
@@ -699,7 +715,16 @@ const JsonNode & getSchemaByName(std::string name)
 
 const JsonNode & JsonUtils::getSchema(std::string URI)
 {
-	std::vector<std::string> segments;
+	// already resolved references, to avoid parsing of URI and json pointer on every $ref
+	static std::unordered_map<std::string, const JsonNode *> resolvedSchemas;
+	static boost::shared_mutex resolvedSchemasMutex;
+
+	{
+		boost::shared_lock<boost::shared_mutex> lock(resolvedSchemasMutex);
+		auto it = resolvedSchemas.find(URI);
+		if (it != resolvedSchemas.end())
+			return *it->second;
+	}
 
 	size_t posColon = URI.find(':');
 	size_t posHash  = URI.find('#');
@@ -710,15 +735,20 @@ const JsonNode & JsonUtils::getSchema(std::string URI)
 
 	if (protocolName != "vcmi")
 	{
-		logGlobal->errorStream() << "Error: unsupported URI protocol for schema: " << segments[0];
+		logGlobal->errorStream() << "Error: unsupported URI protocol for schema: " << protocolName;
 		return nullNode;
 	}
 
 	// check if json pointer if present (section after hash in string)
+	const JsonNode * schema;
 	if (posHash == std::string::npos || posHash == URI.size() - 1)
-		return getSchemaByName(filename);
+		schema = &getSchemaByName(filename);
 	else
-		return getSchemaByName(filename).resolvePointer(URI.substr(posHash + 1));
+		schema = &getSchemaByName(filename).resolvePointer(URI.substr(posHash + 1));
+
+	boost::unique_lock<boost::shared_mutex> lock(resolvedSchemasMutex);
+	resolvedSchemas[URI] = schema;
+	return *schema;
 }
 
 void JsonUtils::merge(JsonNode & dest, JsonNode & source)
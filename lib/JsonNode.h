@@ -59,11 +59,14 @@ public:
 	explicit JsonNode(ResourceID && fileURI, bool & isValidSyntax);
 	//Copy c-tor
 	JsonNode(const JsonNode &copy);
+	//Move c-tor, noexcept so std::vector moves nodes on reallocation instead of copying them
+	JsonNode(JsonNode &&other) BOOST_NOEXCEPT;
 
 	~JsonNode();
 
-	void swap(JsonNode &b);
-	JsonNode& operator =(JsonNode node);
+	void swap(JsonNode &b) BOOST_NOEXCEPT;
+	JsonNode& operator =(const JsonNode &node);
+	JsonNode& operator =(JsonNode &&node) BOOST_NOEXCEPT;
 
 	bool operator == (const JsonNode &other) const;
 	bool operator != (const JsonNode &other) const;
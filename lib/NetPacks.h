@@ -539,6 +539,8 @@ struct RemoveObject : public CPackForClient
 
 	ObjectInstanceID id;
 
+	std::set<int3> blockedTiles; //used locally during applying to client
+
 	template <typename Handler> void serialize(Handler &h, const int version)
 	{
 		h & id;
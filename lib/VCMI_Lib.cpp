@@ -29,6 +29,9 @@
 #include "CConsoleHandler.h"
 #include "rmg/CRmgTemplateStorage.h"
 #include "mapping/CMapEditManager.h"
+#include "CConfigHandler.h"
+#include "serializer/BinaryDeserializer.h"
+#include "serializer/BinarySerializer.h"
 
 LibClasses * VLC = nullptr;
 
@@ -119,7 +122,22 @@ void LibClasses::init()
 
 	logGlobal->infoStream()<<"\tInitializing handlers: "<< totalTime.getDiff();
 
-	modh->load();
+	modh->updateChecksums();
+
+	const bool useContentCache = settings["general"]["useContentCache"].Bool();
+	const auto contentCacheFile = VCMIDirs::get().userCachePath() / "contentCache.vcc";
+	const ui32 contentChecksum = modh->getContentChecksum();
+
+	if (useContentCache && loadContentCache(contentCacheFile, contentChecksum))
+	{
+		modh->loadUncachedContent();
+	}
+	else
+	{
+		modh->load();
+		if (useContentCache)
+			saveContentCache(contentCacheFile, contentChecksum);
+	}
 
 	modh->afterLoad();
 
@@ -127,6 +145,85 @@ void LibClasses::init()
 	//TODO: This should be done every time mod config changes
 }
 
+static const std::string CONTENT_CACHE_MAGIC = "VCMIContentCache";
+
+template <typename Handler> void LibClasses::serializeContent(Handler &h, const int version)
+{
+	h & *heroh & *arth & *creh & *townh & *objh & *objtypeh & *spellh;
+	h & modh->identifiers;
+}
+
+bool LibClasses::loadContentCache(const boost::filesystem::path & file, ui32 checksum)
+{
+	if (!boost::filesystem::exists(file))
+		return false;
+
+	CStopWatch timer;
+	std::unique_ptr<CLoadFile> cache;
+
+	// all checks must be done before any handler is touched - after that there is no way back
+	try
+	{
+		cache = make_unique<CLoadFile>(file);
+		cache->checkMagicBytes(CONTENT_CACHE_MAGIC);
+
+		ui32 cachedChecksum;
+		*cache >> cachedChecksum;
+
+		if (cache->serializer.fileVersion != SERIALIZATION_VERSION || cachedChecksum != checksum)
+		{
+			logGlobal->infoStream() << "\tContent cache is outdated";
+			return false;
+		}
+	}
+	catch(std::exception & e)
+	{
+		logGlobal->warnStream() << "\tFailed to open content cache: " << e.what();
+		return false;
+	}
+
+	try
+	{
+		serializeContent(cache->serializer, cache->serializer.fileVersion);
+	}
+	catch(...)
+	{
+		// handlers are in undefined state. Remove broken cache so next start will work
+		cache.reset();
+		boost::filesystem::remove(file);
+		throw;
+	}
+	logGlobal->infoStream() << "\tContent loaded from cache: " << timer.getDiff() << " ms";
+	return true;
+}
+
+void LibClasses::saveContentCache(const boost::filesystem::path & file, ui32 checksum)
+{
+	CStopWatch timer;
+	// write into temporary file first so crash during saving won't leave broken cache
+	// unique name - client and server may try to create cache at the same time
+	const boost::filesystem::path tempFile = boost::filesystem::unique_path(file.string() + ".%%%%%%%%.tmp");
+
+	try
+	{
+		{
+			CSaveFile cache(tempFile);
+			cache.putMagicBytes(CONTENT_CACHE_MAGIC);
+			cache << checksum;
+			serializeContent(cache.serializer, SERIALIZATION_VERSION);
+		}
+		boost::filesystem::rename(tempFile, file);
+	}
+	catch(std::exception & e)
+	{
+		logGlobal->warnStream() << "\tFailed to save content cache: " << e.what();
+		boost::system::error_code ec;
+		boost::filesystem::remove(tempFile, ec);
+		return;
+	}
+	logGlobal->infoStream() << "\tContent cache saved: " << timer.getDiff() << " ms";
+}
+
 void LibClasses::clear()
 {
 	delete generaltexth;
@@ -32,6 +32,13 @@ class DLL_LINKAGE LibClasses
 
 	void callWhenDeserializing(); //should be called only by serialize !!!
 	void makeNull(); //sets all handler pointers to null
+
+	/// content cache - all handlers data loaded from mods, stored to skip loading on next start
+	/// returns false if cache is missing or was created with different set of mods
+	bool loadContentCache(const boost::filesystem::path & file, ui32 checksum);
+	void saveContentCache(const boost::filesystem::path & file, ui32 checksum);
+
+	template <typename Handler> void serializeContent(Handler &h, const int version);
 public:
 	bool IS_AI_ENABLED; //unused?
 
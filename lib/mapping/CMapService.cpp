@@ -107,10 +107,8 @@ static JsonNode loadPatches(std::string path)
 
 std::unique_ptr<IMapPatcher> CMapService::getMapPatcher(std::string scenarioName)
 {
-	static JsonNode node;
-
-	if (node.isNull())
-		node = loadPatches("config/mapOverrides.json");
+	// headers may be loaded from multiple threads - initialization of local static is thread-safe, lookups are read-only
+	static const JsonNode node = loadPatches("config/mapOverrides.json");
 
 	boost::to_lower(scenarioName);
 	logGlobal->debugStream() << "Request to patch map " << scenarioName;
@@ -10,6 +10,7 @@
 #include "../filesystem/Filesystem.h"
 #include "CZonePlacer.h"
 #include "../mapObjects/CObjectClassesHandler.h"
+#include "../CThreadHelper.h"
 
 static const int3 dirs4[] = {int3(0,1,0),int3(0,-1,0),int3(-1,0,0),int3(+1,0,0)};
 static const int3 dirsDiagonal[] = { int3(1,1,0),int3(1,-1,0),int3(-1,1,0),int3(-1,-1,0) };
@@ -48,8 +49,8 @@ void CMapGenerator::foreachDiagonaltNeighbour(const int3& pos, std::function<voi
 
 
 CMapGenerator::CMapGenerator() :
-	mapGenOptions(nullptr), randomSeed(0), editManager(nullptr),
-	zonesTotal(0), tiles(nullptr), prisonsRemaining(0),
+	mapGenOptions(nullptr), randomSeed(0), threadLimit(0), editManager(nullptr),
+	zonesTotal(0), prisonsRemaining(0),
     monolithIndex(0)
 {
 }
@@ -58,39 +59,15 @@ void CMapGenerator::initTiles()
 {
 	map->initTerrain();
 
-	int width = map->width;
-	int height = map->height;
-
-	int level = map->twoLevel ? 2 : 1;
-	tiles = new CTileInfo**[width];
-	for (int i = 0; i < width; ++i)
-	{
-		tiles[i] = new CTileInfo*[height];
-		for (int j = 0; j < height; ++j)
-		{
-			tiles[i][j] = new CTileInfo[level];
-		}
-	}
-
-	zoneColouring.resize(boost::extents[map->twoLevel ? 2 : 1][map->width][map->height]);
+	size_t tilesCount = size_t(map->width) * map->height * (map->twoLevel ? 2 : 1);
+	tiles.assign(tilesCount, CTileInfo());
+	zoneColouring.assign(tilesCount, 0);
 }
 
 CMapGenerator::~CMapGenerator()
 {
-	if (tiles)
-	{
-		int width = mapGenOptions->getWidth();
-		int height = mapGenOptions->getHeight();
-		for (int i=0; i < width; i++)
-		{
-			for(int j=0; j < height; j++)
-			{
-				delete [] tiles[i][j];
-			}
-			delete [] tiles[i];
-		}
-		delete [] tiles;
-	}
+	for (auto zone : zones)
+		delete zone.second;
 }
 
 void CMapGenerator::initPrisonsRemaining()
@@ -263,8 +240,9 @@ void CMapGenerator::genZones()
 	editManager->getTerrainSelection().selectRange(MapRect(int3(0, 0, 0), mapGenOptions->getWidth(), mapGenOptions->getHeight()));
 	editManager->drawTerrain(ETerrainType::GRASS, &rand);
 
-	auto tmpl = mapGenOptions->getMapTemplate();
-	zones = tmpl->getZones(); //copy from template (refactor?)
+	//zones keep state of generation, so every map needs its own copies of template zones
+	for (const auto & zone : mapGenOptions->getMapTemplate()->getZones())
+		zones[zone.first] = new CRmgTemplateZone(*zone.second);
 
 	CZonePlacer placer(this);
 	placer.placeZones(mapGenOptions, &rand);
@@ -281,6 +259,10 @@ void CMapGenerator::fillZones()
 
 	findZonesForQuestArts();
 
+	//every zone gets its own generator so the result does not depend on order in which zones are processed
+	for (auto it : zones)
+		it.second->setRandomSeed(rand.nextInt());
+
 	logGlobal->infoStream() << "Started filling zones";
 
 	//we need info about all town types to evaluate dwellings and pandoras with creatures properly
@@ -299,6 +281,11 @@ void CMapGenerator::fillZones()
 
 	createConnections2(); //subterranean gates and monoliths
 
+	for (auto it : zones)
+		it.second->initTerrainType(this);
+
+	createZonePaths();
+
 	std::vector<CRmgTemplateZone*> treasureZones;
 	for (auto it : zones)
 	{
@@ -372,6 +359,42 @@ void CMapGenerator::fillZones()
 	logGlobal->infoStream() << "Zones filled successfully";
 }
 
+void CMapGenerator::createZonePaths()
+{
+	//paths never leave their zone and each zone has its own random generator, so zones are processed concurrently
+	std::vector<Task> tasks;
+	std::vector<std::exception_ptr> errors(zones.size());
+
+	size_t index = 0;
+	for (auto it : zones)
+	{
+		CRmgTemplateZone * zone = it.second;
+		std::exception_ptr * error = &errors[index++];
+
+		tasks.push_back([=]()
+		{
+			try
+			{
+				zone->createPaths(this);
+			}
+			catch (...)
+			{
+				*error = std::current_exception();
+			}
+		});
+	}
+
+	ui32 threads = threadLimit ? threadLimit : std::max((ui32)1, boost::thread::hardware_concurrency());
+	CThreadHelper helper(&tasks, std::min<ui32>(tasks.size(), threads));
+	helper.run();
+
+	for (auto & error : errors)
+	{
+		if (error)
+			std::rethrow_exception(error);
+	}
+}
+
 void CMapGenerator::createObstaclesCommon1()
 {
 	if (map->twoLevel) //underground
@@ -462,8 +485,8 @@ void CMapGenerator::findZonesForQuestArts()
 
 	for (auto connection : mapGenOptions->getMapTemplate()->getConnections())
 	{
-		auto zoneA = connection.getZoneA();
-		auto zoneB = connection.getZoneB();
+		auto zoneA = zones[connection.getZoneA()->getId()];
+		auto zoneB = zones[connection.getZoneB()->getId()];
 
 		if (zoneA->getId() > zoneB->getId())
 		{
@@ -480,8 +503,8 @@ void CMapGenerator::createDirectConnections()
 {
 	for (auto connection : mapGenOptions->getMapTemplate()->getConnections())
 	{
-		auto zoneA = connection.getZoneA();
-		auto zoneB = connection.getZoneB();
+		auto zoneA = zones[connection.getZoneA()->getId()];
+		auto zoneB = zones[connection.getZoneB()->getId()];
 
 		//rearrange tiles in random order
 		auto tilesCopy = zoneA->getTileInfo();
@@ -560,8 +583,8 @@ void CMapGenerator::createConnections2()
 {
 	for (auto & connection : connectionsLeft)
 	{
-		auto zoneA = connection.getZoneA();
-		auto zoneB = connection.getZoneB();
+		auto zoneA = zones[connection.getZoneA()->getId()];
+		auto zoneB = zones[connection.getZoneB()->getId()];
 
 		int3 guardPos(-1, -1, -1);
 
@@ -697,6 +720,11 @@ void CMapGenerator::checkIsOnMap(const int3& tile) const
 		throw  rmgException(boost::to_string(boost::format("Tile %s is outside the map") % tile));
 }
 
+size_t CMapGenerator::getTileIndex(const int3& tile) const
+{
+	return (size_t(tile.z) * map->height + tile.y) * map->width + tile.x;
+}
+
 
 std::map<TRmgTemplateZoneId, CRmgTemplateZone*> CMapGenerator::getZones() const
 {
@@ -707,74 +735,74 @@ bool CMapGenerator::isBlocked(const int3 &tile) const
 {
 	checkIsOnMap(tile);
 
-	return tiles[tile.x][tile.y][tile.z].isBlocked();
+	return tiles[getTileIndex(tile)].isBlocked();
 }
 bool CMapGenerator::shouldBeBlocked(const int3 &tile) const
 {
 	checkIsOnMap(tile);
 
-	return tiles[tile.x][tile.y][tile.z].shouldBeBlocked();
+	return tiles[getTileIndex(tile)].shouldBeBlocked();
 }
 bool CMapGenerator::isPossible(const int3 &tile) const
 {
 	checkIsOnMap(tile);
 
-	return tiles[tile.x][tile.y][tile.z].isPossible();
+	return tiles[getTileIndex(tile)].isPossible();
 }
 bool CMapGenerator::isFree(const int3 &tile) const
 {
 	checkIsOnMap(tile);
 
-	return tiles[tile.x][tile.y][tile.z].isFree();
+	return tiles[getTileIndex(tile)].isFree();
 }
 bool CMapGenerator::isUsed(const int3 &tile) const
 {
 	checkIsOnMap(tile);
 
-	return tiles[tile.x][tile.y][tile.z].isUsed();
+	return tiles[getTileIndex(tile)].isUsed();
 }
 
 bool CMapGenerator::isRoad(const int3& tile) const
 {
 	checkIsOnMap(tile);
 
-	return tiles[tile.x][tile.y][tile.z].isRoad();
+	return tiles[getTileIndex(tile)].isRoad();
 }
 
 void CMapGenerator::setOccupied(const int3 &tile, ETileType::ETileType state)
 {
 	checkIsOnMap(tile);
 
-	tiles[tile.x][tile.y][tile.z].setOccupied(state);
+	tiles[getTileIndex(tile)].setOccupied(state);
 }
 
 void CMapGenerator::setRoad(const int3& tile, ERoadType::ERoadType roadType)
 {
 	checkIsOnMap(tile);
 
-	tiles[tile.x][tile.y][tile.z].setRoadType(roadType);
+	tiles[getTileIndex(tile)].setRoadType(roadType);
 }
 
 
-CTileInfo CMapGenerator::getTile(const int3& tile) const
+const CTileInfo & CMapGenerator::getTile(const int3& tile) const
 {
 	checkIsOnMap(tile);
 
-	return tiles[tile.x][tile.y][tile.z];
+	return tiles[getTileIndex(tile)];
 }
 
 TRmgTemplateZoneId CMapGenerator::getZoneID(const int3& tile) const
 {
 	checkIsOnMap(tile);
 
-	return zoneColouring[tile.z][tile.x][tile.y];
+	return zoneColouring[getTileIndex(tile)];
 }
 
 void CMapGenerator::setZoneID(const int3& tile, TRmgTemplateZoneId zid)
 {
 	checkIsOnMap(tile);
 
-	zoneColouring[tile.z][tile.x][tile.y] = zid;
+	zoneColouring[getTileIndex(tile)] = zid;
 }
 
 bool CMapGenerator::isAllowedSpell(SpellID sid) const
@@ -792,14 +820,14 @@ void CMapGenerator::setNearestObjectDistance(int3 &tile, float value)
 {
 	checkIsOnMap(tile);
 
-	tiles[tile.x][tile.y][tile.z].setNearestObjectDistance(value);
+	tiles[getTileIndex(tile)].setNearestObjectDistance(value);
 }
 
 float CMapGenerator::getNearestObjectDistance(const int3 &tile) const
 {
 	checkIsOnMap(tile);
 
-	return tiles[tile.x][tile.y][tile.z].getNearestObjectDistance();
+	return tiles[getTileIndex(tile)].getNearestObjectDistance();
 }
 
 int CMapGenerator::getNextMonlithIndex()
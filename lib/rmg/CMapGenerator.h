@@ -61,6 +61,7 @@ public:
 	std::unique_ptr<CMap> map;
 	CRandomGenerator rand;
 	int randomSeed;
+	ui32 threadLimit; //maximal number of worker threads, 0 - hardware concurrency
 	CMapEditManager * editManager;
 
 	std::map<TRmgTemplateZoneId, CRmgTemplateZone*> getZones() const;
@@ -81,7 +82,7 @@ public:
 	void setOccupied(const int3 &tile, ETileType::ETileType state);
 	void setRoad(const int3 &tile, ERoadType::ERoadType roadType);
 
-	CTileInfo getTile(const int3 & tile) const;
+	const CTileInfo & getTile(const int3 & tile) const;
 	bool isAllowedSpell(SpellID sid) const;
 
 	float getNearestObjectDistance(const int3 &tile) const;
@@ -106,14 +107,16 @@ private:
 	std::map<TFaction, ui32> zonesPerFaction;
 	ui32 zonesTotal; //zones that have their main town only
 
-	CTileInfo*** tiles;
-	boost::multi_array<TRmgTemplateZoneId, 3> zoneColouring; //[z][x][y]
+	//both indexed by getTileIndex()
+	std::vector<CTileInfo> tiles;
+	std::vector<TRmgTemplateZoneId> zoneColouring;
 
 	int prisonsRemaining;
 	//int questArtsRemaining;
 	int monolithIndex;
 	std::vector<ArtifactID> questArtifacts;
 	void checkIsOnMap(const int3 &tile) const; //throws
+	size_t getTileIndex(const int3 &tile) const; //tiles of one row are stored next to each other
 
 	/// Generation methods
 	std::string getMapDescription() const;
@@ -125,6 +128,7 @@ private:
 	void initTiles();
 	void genZones();
 	void fillZones();
+	void createZonePaths();
 	void createObstaclesCommon1();
 	void createObstaclesCommon2();
 
@@ -0,0 +1,205 @@
+/*
+ * CMapPoolGenerator.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "CMapPoolGenerator.h"
+
+#include "CMapGenerator.h"
+#include "CMapGenOptions.h"
+#include "CRmgTemplate.h"
+#include "CRmgTemplateStorage.h"
+#include "../CThreadHelper.h"
+#include "../JsonNode.h"
+#include "../VCMI_Lib.h"
+#include "../filesystem/CMemoryBuffer.h"
+#include "../mapping/CMap.h"
+#include "../mapping/MapFormatJson.h"
+
+CMapGenJob::CMapGenJob() : width(CMapHeader::MAP_SIZE_MIDDLE), height(CMapHeader::MAP_SIZE_MIDDLE),
+	twoLevels(true), playerCount(CMapGenOptions::RANDOM_SIZE), seed(0)
+{
+}
+
+CMapGenJobResult::CMapGenJobResult() : success(false), generationTime(0), savingTime(0)
+{
+}
+
+CMapPoolGenerator::CMapPoolGenerator(const boost::filesystem::path & outputDir) : outputDir(outputDir)
+{
+}
+
+std::vector<CMapGenJob> CMapPoolGenerator::parseJobs(const JsonNode & config)
+{
+	std::vector<CMapGenJob> jobs;
+
+	for(const JsonNode & entry : config["maps"].Vector())
+	{
+		CMapGenJob job;
+		job.templateName = entry["template"].String();
+		if(!entry["width"].isNull())
+			job.width = entry["width"].Float();
+		if(!entry["height"].isNull())
+			job.height = entry["height"].Float();
+		if(!entry["twoLevels"].isNull())
+			job.twoLevels = entry["twoLevels"].Bool();
+		if(!entry["players"].isNull())
+			job.playerCount = entry["players"].Float();
+
+		int count = entry["count"].isNull() ? 1 : entry["count"].Float();
+		int firstSeed = entry["seed"].isNull() ? std::time(nullptr) : entry["seed"].Float();
+
+		std::string baseName = entry["name"].String();
+		if(baseName.empty())
+			baseName = boost::str(boost::format("%s_%dx%d") % (job.templateName.empty() ? "random" : job.templateName) % job.width % job.height);
+
+		for(int i = 0; i < count; i++)
+		{
+			job.seed = firstSeed + i;
+			job.name = count > 1 || entry["name"].isNull() ? boost::str(boost::format("%s_%d") % baseName % job.seed) : baseName;
+			jobs.push_back(job);
+		}
+	}
+	return jobs;
+}
+
+std::vector<CMapGenJobResult> CMapPoolGenerator::generate(const std::vector<CMapGenJob> & jobs, int threads) const
+{
+	std::vector<CMapGenJobResult> results(jobs.size());
+	if(jobs.empty())
+		return results;
+
+	boost::filesystem::create_directories(outputDir);
+
+	if(threads <= 0)
+		threads = std::max((ui32)1, boost::thread::hardware_concurrency());
+
+	//every generator runs its own workers as well, so threads are split between jobs to not oversubscribe CPU
+	ui32 workers = std::min<ui32>(jobs.size(), threads);
+	ui32 generatorThreads = std::max<ui32>(1, threads / workers);
+
+	//generator and options are created per job, objects of generated maps are attached to handler nodes
+	//in VLC (creatures, artifacts) and CBonusSystemNode serializes these changes of bonus tree
+	std::vector<Task> tasks;
+	for(size_t i = 0; i < jobs.size(); i++)
+	{
+		tasks.push_back([this, &jobs, &results, i, generatorThreads]()
+		{
+			results[i] = runJob(jobs[i], generatorThreads);
+		});
+	}
+
+	CThreadHelper helper(&tasks, workers);
+	helper.run();
+
+	writeIndex(results);
+	return results;
+}
+
+CMapGenJobResult CMapPoolGenerator::runJob(const CMapGenJob & job, ui32 generatorThreads) const
+{
+	CMapGenJobResult result;
+	result.job = job;
+	result.file = outputDir / (job.name + ".vmap");
+
+	try
+	{
+		CMapGenOptions opt;
+		opt.setWidth(job.width);
+		opt.setHeight(job.height);
+		opt.setHasTwoLevels(job.twoLevels);
+		opt.setPlayerCount(job.playerCount);
+		opt.setPlayerTypeForStandardPlayer(PlayerColor(0), EPlayerType::HUMAN);
+
+		if(!job.templateName.empty())
+		{
+			for(const auto & tpl : VLC->tplh->getTemplates())
+			{
+				if(tpl.second->getName() == job.templateName)
+					opt.setMapTemplate(tpl.second);
+			}
+			if(!opt.getMapTemplate())
+				throw std::runtime_error("Unknown template " + job.templateName);
+		}
+
+		if(!opt.checkOptions())
+			throw std::runtime_error("No template is suitable for given options");
+
+		auto start = boost::posix_time::microsec_clock::universal_time();
+
+		CMapGenerator gen;
+		gen.threadLimit = generatorThreads;
+		auto map = gen.generate(&opt, job.seed);
+
+		auto generated = boost::posix_time::microsec_clock::universal_time();
+
+		CMemoryBuffer buffer;
+		{
+			CMapSaverJson saver(&buffer);
+			saver.saveMap(map);
+		}
+		boost::filesystem::ofstream file(result.file, boost::filesystem::ofstream::binary | boost::filesystem::ofstream::trunc);
+		file.write((const char *)buffer.getBuffer().data(), buffer.getSize());
+		file.close();
+		if(!file)
+			throw std::runtime_error("Failed to write " + result.file.string());
+
+		auto saved = boost::posix_time::microsec_clock::universal_time();
+
+		result.usedTemplate = opt.getMapTemplate()->getName();
+		result.generationTime = (generated - start).total_microseconds() / 1000.0;
+		result.savingTime = (saved - generated).total_microseconds() / 1000.0;
+		result.success = true;
+
+		logGlobal->infoStream() << boost::format("Generated map %s (template %s, seed %d) in %.0f ms, saved in %.0f ms")
+			% job.name % result.usedTemplate % job.seed % result.generationTime % result.savingTime;
+	}
+	catch(rmgException & e)
+	{
+		result.error = e.what();
+	}
+	catch(std::exception & e)
+	{
+		result.error = e.what();
+	}
+
+	if(!result.success)
+		logGlobal->errorStream() << "Failed to generate map " << job.name << ": " << result.error;
+	return result;
+}
+
+void CMapPoolGenerator::writeIndex(const std::vector<CMapGenJobResult> & results) const
+{
+	JsonNode index(JsonNode::DATA_STRUCT);
+	JsonVector & maps = index["maps"].Vector();
+
+	for(const auto & result : results)
+	{
+		JsonNode entry(JsonNode::DATA_STRUCT);
+		entry["name"].String() = result.job.name;
+		entry["template"].String() = result.usedTemplate;
+		entry["seed"].Float() = result.job.seed;
+		entry["width"].Float() = result.job.width;
+		entry["height"].Float() = result.job.height;
+		entry["twoLevels"].Bool() = result.job.twoLevels;
+		entry["success"].Bool() = result.success;
+		if(result.success)
+		{
+			entry["file"].String() = result.file.filename().string();
+			entry["generationTime"].Float() = result.generationTime;
+			entry["savingTime"].Float() = result.savingTime;
+		}
+		else
+			entry["error"].String() = result.error;
+		maps.push_back(entry);
+	}
+
+	boost::filesystem::ofstream file(outputDir / "pool.json", boost::filesystem::ofstream::trunc);
+	file << index;
+}
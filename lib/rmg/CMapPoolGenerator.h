@@ -0,0 +1,63 @@
+/*
+ * CMapPoolGenerator.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#pragma once
+
+class JsonNode;
+
+/// Description of single random map to pre-generate.
+struct DLL_LINKAGE CMapGenJob
+{
+	std::string name; //name of map file without extension
+	std::string templateName; //empty if template should be chosen randomly
+	si32 width, height;
+	bool twoLevels;
+	si8 playerCount; //CMapGenOptions::RANDOM_SIZE for random
+	int seed;
+
+	CMapGenJob();
+};
+
+/// Outcome of single map generation job
+struct DLL_LINKAGE CMapGenJobResult
+{
+	CMapGenJob job;
+	std::string usedTemplate;
+	boost::filesystem::path file;
+	bool success;
+	std::string error;
+	double generationTime; //in milliseconds
+	double savingTime; //in milliseconds
+
+	CMapGenJobResult();
+};
+
+/// Generates random maps in batch and stores them as VCMI maps in a pool directory, so they can be
+/// offered to players without waiting for the generator. Every job uses its own generator and options,
+/// jobs are processed in parallel and share the thread limit with workers of their generators.
+class DLL_LINKAGE CMapPoolGenerator
+{
+public:
+	CMapPoolGenerator(const boost::filesystem::path & outputDir);
+
+	/// Reads jobs from config in format {"maps" : [{"name", "template", "width", "height", "twoLevels", "players", "seed", "count"}]}
+	/// Jobs with count greater than one are expanded into maps with consecutive seeds.
+	static std::vector<CMapGenJob> parseJobs(const JsonNode & config);
+
+	/// Runs all jobs using up to threads workers (0 - hardware concurrency) and writes pool.json index
+	/// with results into output directory. Failed jobs are reported in results, not thrown.
+	std::vector<CMapGenJobResult> generate(const std::vector<CMapGenJob> & jobs, int threads = 0) const;
+
+private:
+	boost::filesystem::path outputDir;
+
+	CMapGenJobResult runJob(const CMapGenJob & job, ui32 generatorThreads) const;
+	void writeIndex(const std::vector<CMapGenJobResult> & results) const;
+};
@@ -169,6 +169,29 @@ CRmgTemplateZone::CRmgTemplateZone() :
 	terrainTypes = getDefaultTerrainTypes();
 }
 
+CRmgTemplateZone::CRmgTemplateZone(const CRmgTemplateZone & other) :
+	id(other.id),
+	type(other.type),
+	size(other.size),
+	owner(other.owner),
+	playerTowns(other.playerTowns),
+	neutralTowns(other.neutralTowns),
+	townsAreSameType(other.townsAreSameType),
+	townTypes(other.townTypes),
+	monsterTypes(other.monsterTypes),
+	matchTerrainToTown(other.matchTerrainToTown),
+	terrainTypes(other.terrainTypes),
+	mines(other.mines),
+	townType(ETownType::NEUTRAL),
+	terrainType (ETerrainType::GRASS),
+	questArtZone(nullptr),
+	zoneMonsterStrength(other.zoneMonsterStrength),
+	treasureInfo(other.treasureInfo),
+	minGuardedValue(0),
+	connections(other.connections)
+{
+}
+
 TRmgTemplateZoneId CRmgTemplateZone::getId() const
 {
 	return id;
@@ -333,6 +356,11 @@ void CRmgTemplateZone::setMonsterStrength (EMonsterStrength::EMonsterStrength va
 	zoneMonsterStrength = val;
 }
 
+void CRmgTemplateZone::setRandomSeed(int seed)
+{
+	rand.setSeed(seed);
+}
+
 void CRmgTemplateZone::addTreasureInfo(CTreasureInfo & info)
 {
 	treasureInfo.push_back(info);
@@ -343,7 +371,7 @@ std::vector<CTreasureInfo> CRmgTemplateZone::getTreasureInfo()
 	return treasureInfo;
 }
 
-std::set<int3>* CRmgTemplateZone::getFreePaths()
+CTileSet* CRmgTemplateZone::getFreePaths()
 {
 	return &freePaths;
 }
@@ -388,11 +416,11 @@ void CRmgTemplateZone::addTile (const int3 &pos)
 	tileinfo.insert(pos);
 }
 
-std::set<int3> CRmgTemplateZone::getTileInfo () const
+const CTileSet & CRmgTemplateZone::getTileInfo () const
 {
 	return tileinfo;
 }
-std::set<int3> CRmgTemplateZone::getPossibleTiles() const
+const CTileSet & CRmgTemplateZone::getPossibleTiles() const
 {
 	return possibleTiles;
 }
@@ -409,10 +437,11 @@ void CRmgTemplateZone::discardDistantTiles (CMapGenerator* gen, float distance)
 	//		//gen->setOccupied(tile, ETileType::BLOCKED); //fixme: crash at rendering?
 	//	}
 	//}
-	vstd::erase_if (tileinfo, [distance, this](const int3 &tile) -> bool
+	for (auto tile : tileinfo)
 	{
-		return tile.dist2d(this->pos) > distance;
-	});
+		if (tile.dist2d(this->pos) > distance)
+			tileinfo.erase(tile);
+	}
 }
 
 void CRmgTemplateZone::clearTiles()
@@ -422,10 +451,14 @@ void CRmgTemplateZone::clearTiles()
 
 void CRmgTemplateZone::initFreeTiles (CMapGenerator* gen)
 {
-	vstd::copy_if (tileinfo, vstd::set_inserter(possibleTiles), [gen](const int3 &tile) -> bool
+	for (auto tile : tileinfo)
 	{
-		return gen->isPossible(tile);
-	});
+		if (gen->isPossible(tile))
+		{
+			possibleTiles.insert(tile);
+			tilesByDistance[gen->getNearestObjectDistance(tile)].insert(tile);
+		}
+	}
 	if (freePaths.empty())
 	{
 		gen->setOccupied(pos, ETileType::FREE);
@@ -465,7 +498,7 @@ void CRmgTemplateZone::fractalize(CMapGenerator* gen)
 			freePaths.insert(tile);
 	}
 	std::vector<int3> clearedTiles (freePaths.begin(), freePaths.end());
-	std::set<int3> possibleTiles;
+	CTileSet possibleTiles;
 	std::set<int3> tilesToIgnore; //will be erased in this iteration
 
 	//the more treasure density, the greater distance between paths. Scaling is experimental.
@@ -493,7 +526,7 @@ void CRmgTemplateZone::fractalize(CMapGenerator* gen)
 		{
 			//link tiles in random order
 			std::vector<int3> tilesToMakePath(possibleTiles.begin(), possibleTiles.end());
-			RandomGeneratorUtil::randomShuffle(tilesToMakePath, gen->rand);
+			RandomGeneratorUtil::randomShuffle(tilesToMakePath, rand);
 
 			int3 nodeFound(-1, -1, -1);
 
@@ -532,7 +565,7 @@ void CRmgTemplateZone::fractalize(CMapGenerator* gen)
 			for (auto tileToClear : tilesToIgnore)
 			{
 				//these tiles are already connected, ignore them
-				vstd::erase_if_present(possibleTiles, tileToClear);
+				possibleTiles.erase(tileToClear);
 			}
 			if (!nodeFound.valid()) //nothing else can be done (?)
 				break;
@@ -642,7 +675,7 @@ void CRmgTemplateZone::connectLater(CMapGenerator* gen)
 	}
 }
 
-bool CRmgTemplateZone::crunchPath(CMapGenerator* gen, const int3 &src, const int3 &dst, bool onlyStraight, std::set<int3>* clearedTiles)
+bool CRmgTemplateZone::crunchPath(CMapGenerator* gen, const int3 &src, const int3 &dst, bool onlyStraight, CTileSet* clearedTiles)
 {
 /*
 make shortest path with free tiles, reachning dst or closest already free tile. Avoid blocks.
@@ -675,9 +708,9 @@ do not leave zone border
 				}
 				if (pos.dist2dSQ (dst) < distance)
 				{
-					if (!gen->isBlocked(pos))
+					if (gen->getZoneID(pos) == id) //check zone first, tiles of other zones may be modified concurrently
 					{
-						if (gen->getZoneID(pos) == id)
+						if (!gen->isBlocked(pos))
 						{
 							if (gen->isPossible(pos))
 							{
@@ -917,7 +950,7 @@ bool CRmgTemplateZone::connectPath(CMapGenerator* gen, const int3& src, bool onl
 	for (auto tile : closed) //these tiles are sealed off and can't be connected anymore
 	{
 		gen->setOccupied (tile, ETileType::BLOCKED);
-		vstd::erase_if_present(possibleTiles, tile);
+		possibleTiles.erase(tile);
 	}
 	return false;
 }
@@ -1048,10 +1081,10 @@ bool CRmgTemplateZone::addMonster(CMapGenerator* gen, int3 &pos, si32 strength,
 	}
 	if (possibleCreatures.size())
 	{
-		creId = *RandomGeneratorUtil::nextItem(possibleCreatures, gen->rand);
+		creId = *RandomGeneratorUtil::nextItem(possibleCreatures, rand);
 		amount = strength / VLC->creh->creatures[creId]->AIValue;
 		if (amount >= 4)
-			amount *= gen->rand.nextDouble(0.75, 1.25);
+			amount *= rand.nextDouble(0.75, 1.25);
 	}
 	else //just pick any available creature
 	{
@@ -1097,7 +1130,7 @@ bool CRmgTemplateZone::createTreasurePile(CMapGenerator* gen, int3 &pos, float m
 	int maxValue = treasureInfo.max;
 	int minValue = treasureInfo.min;
 
-	ui32 desiredValue = (gen->rand.nextInt(minValue, maxValue));
+	ui32 desiredValue = (rand.nextInt(minValue, maxValue));
 
 	int currentValue = 0;
 	CGObjectInstance * object = nullptr;
@@ -1167,7 +1200,7 @@ bool CRmgTemplateZone::createTreasurePile(CMapGenerator* gen, int3 &pos, float m
 
 			//randomize next position from among possible ones
 			std::vector<int3> boundaryCopy (boundary.begin(), boundary.end());
-			//RandomGeneratorUtil::randomShuffle(boundaryCopy, gen->rand);
+			//RandomGeneratorUtil::randomShuffle(boundaryCopy, rand);
 			auto chooseTopTile = [](const int3 & lhs, const int3 & rhs) -> bool
 			{
 				return lhs.y < rhs.y;
@@ -1312,7 +1345,7 @@ bool CRmgTemplateZone::createTreasurePile(CMapGenerator* gen, int3 &pos, float m
 	else //we did not place eveyrthing successfully
 	{
 		gen->setOccupied(pos, ETileType::BLOCKED); //TODO: refactor stop condition
-		vstd::erase_if_present(possibleTiles, pos);
+		possibleTiles.erase(pos);
 		return false;
 	}
 }
@@ -1345,9 +1378,9 @@ void CRmgTemplateZone::initTownType (CMapGenerator* gen)
 				if(!this->townsAreSameType)
 				{
 					if (townTypes.size())
-						subType = *RandomGeneratorUtil::nextItem(townTypes, gen->rand);
+						subType = *RandomGeneratorUtil::nextItem(townTypes, rand);
 					else
-						subType = *RandomGeneratorUtil::nextItem(getDefaultTownTypes(), gen->rand); //it is possible to have zone with no towns allowed
+						subType = *RandomGeneratorUtil::nextItem(getDefaultTownTypes(), rand); //it is possible to have zone with no towns allowed
 				}
 			}
 
@@ -1456,16 +1489,16 @@ void CRmgTemplateZone::initTownType (CMapGenerator* gen)
 	if (!totalTowns) //if there's no town present, get random faction for dwellings and pandoras
 	{
 		//25% chance for neutral
-		if (gen->rand.nextInt(1, 100) <= 25)
+		if (rand.nextInt(1, 100) <= 25)
 		{
 			townType = ETownType::NEUTRAL;
 		}
 		else
 		{
 			if (townTypes.size())
-				townType = *RandomGeneratorUtil::nextItem(townTypes, gen->rand);
+				townType = *RandomGeneratorUtil::nextItem(townTypes, rand);
 			else if (monsterTypes.size())
-				townType = *RandomGeneratorUtil::nextItem(monsterTypes, gen->rand); //this happens in Clash of Dragons in treasure zones, where all towns are banned
+				townType = *RandomGeneratorUtil::nextItem(monsterTypes, rand); //this happens in Clash of Dragons in treasure zones, where all towns are banned
 			else //just in any case
 				randomizeTownType(gen);
 		}
@@ -1475,9 +1508,9 @@ void CRmgTemplateZone::initTownType (CMapGenerator* gen)
 void CRmgTemplateZone::randomizeTownType (CMapGenerator* gen)
 {
 	if (townTypes.size())
-		townType = *RandomGeneratorUtil::nextItem(townTypes, gen->rand);
+		townType = *RandomGeneratorUtil::nextItem(townTypes, rand);
 	else
-		townType = *RandomGeneratorUtil::nextItem(getDefaultTownTypes(), gen->rand); //it is possible to have zone with no towns allowed, we still need some
+		townType = *RandomGeneratorUtil::nextItem(getDefaultTownTypes(), rand); //it is possible to have zone with no towns allowed, we still need some
 }
 
 void CRmgTemplateZone::initTerrainType (CMapGenerator* gen)
@@ -1486,7 +1519,7 @@ void CRmgTemplateZone::initTerrainType (CMapGenerator* gen)
 	if (matchTerrainToTown && townType != ETownType::NEUTRAL)
 		terrainType = VLC->townh->factions[townType]->nativeTerrain;
 	else
-		terrainType = *RandomGeneratorUtil::nextItem(terrainTypes, gen->rand);
+		terrainType = *RandomGeneratorUtil::nextItem(terrainTypes, rand);
 
 	//TODO: allow new types of terrain?
 	if (pos.z)
@@ -1507,7 +1540,7 @@ void CRmgTemplateZone::paintZoneTerrain (CMapGenerator* gen, ETerrainType terrai
 {
 	std::vector<int3> tiles(tileinfo.begin(), tileinfo.end());
 	gen->editManager->getTerrainSelection().setSelection(tiles);
-	gen->editManager->drawTerrain(terrainType, &gen->rand);
+	gen->editManager->drawTerrain(terrainType, &rand);
 }
 
 bool CRmgTemplateZone::placeMines (CMapGenerator* gen)
@@ -1723,10 +1756,11 @@ void CRmgTemplateZone::createTreasures(CMapGenerator* gen)
 		bool stop = false;
 		do {
 			//optimization - don't check tiles which are not allowed
-			vstd::erase_if(possibleTiles, [gen](const int3 &tile) -> bool
+			for (auto tile : possibleTiles)
 			{
-				return !gen->isPossible(tile);
-			});
+				if (!gen->isPossible(tile))
+					possibleTiles.erase(tile);
+			}
 
 
 			int3 treasureTilePos;
@@ -1760,7 +1794,7 @@ void CRmgTemplateZone::createObstacles1(CMapGenerator * gen)
 			}
 		}
 		gen->editManager->getTerrainSelection().setSelection(accessibleTiles);
-		gen->editManager->drawTerrain(terrainType, &gen->rand);
+		gen->editManager->drawTerrain(terrainType, &rand);
 	}
 }
 
@@ -1804,7 +1838,7 @@ void CRmgTemplateZone::createObstacles2(CMapGenerator* gen)
 
 	auto tryToPlaceObstacleHere = [this, gen, &possibleObstacles](int3& tile, int index)-> bool
 	{
-		auto temp = *RandomGeneratorUtil::nextItem(possibleObstacles[index].second, gen->rand);
+		auto temp = *RandomGeneratorUtil::nextItem(possibleObstacles[index].second, rand);
 		int3 obstaclePos = tile + temp.getBlockMapOffset();
 		if (canObstacleBePlacedHere(gen, temp, obstaclePos)) //can be placed here
 		{
@@ -1819,7 +1853,7 @@ void CRmgTemplateZone::createObstacles2(CMapGenerator* gen)
 	for (auto tile : boost::adaptors::reverse(tileinfo))
 	{
 		//fill tiles that should be blocked with obstacles or are just possible (with some probability)
-		if (gen->shouldBeBlocked(tile) || (gen->isPossible(tile) && gen->rand.nextInt(1,100) < 60))
+		if (gen->shouldBeBlocked(tile) || (gen->isPossible(tile) && rand.nextInt(1,100) < 60))
 		{
 			//start from biggets obstacles
 			for (int i = 0; i < possibleObstacles.size(); i++)
@@ -1843,8 +1877,8 @@ void CRmgTemplateZone::connectRoads(CMapGenerator* gen)
 {
 	logGlobal->debug("Started building roads");
 
-	std::set<int3> roadNodesCopy(roadNodes);
-	std::set<int3> processed;
+	CTileSet roadNodesCopy(roadNodes);
+	CTileSet processed;
 
 	while(!roadNodesCopy.empty())
 	{
@@ -1869,7 +1903,7 @@ void CRmgTemplateZone::connectRoads(CMapGenerator* gen)
 		if (createRoad(gen, node, cross))
 		{
 			processed.insert(cross); //don't draw road starting at end point which is already connected
-			vstd::erase_if_present(roadNodesCopy, cross);
+			roadNodesCopy.erase(cross);
 		}
 
 		processed.insert(node);
@@ -1895,22 +1929,24 @@ void CRmgTemplateZone::drawRoads(CMapGenerator* gen)
 	}
 
 	gen->editManager->getTerrainSelection().setSelection(tiles);
-	gen->editManager->drawRoad(ERoadType::COBBLESTONE_ROAD, &gen->rand);
+	gen->editManager->drawRoad(ERoadType::COBBLESTONE_ROAD, &rand);
 }
 
 
-bool CRmgTemplateZone::fill(CMapGenerator* gen)
+void CRmgTemplateZone::createPaths(CMapGenerator* gen)
 {
-	initTerrainType(gen);
-
 	//zone center should be always clear to allow other tiles to connect
 	gen->setOccupied(pos, ETileType::FREE);
 	freePaths.insert(pos);
 
-	addAllPossibleObjects (gen);
-
 	connectLater(gen); //ideally this should work after fractalize, but fails
 	fractalize(gen);
+}
+
+bool CRmgTemplateZone::fill(CMapGenerator* gen)
+{
+	addAllPossibleObjects (gen);
+
 	placeMines(gen);
 	createRequiredObjects(gen);
 	createTreasures(gen);
@@ -1921,18 +1957,27 @@ bool CRmgTemplateZone::fill(CMapGenerator* gen)
 
 bool CRmgTemplateZone::findPlaceForTreasurePile(CMapGenerator* gen, float min_dist, int3 &pos, int value)
 {
-	float best_distance = 0;
 	bool result = false;
 
 	bool needsGuard = value > minGuardedValue;
+	std::vector<std::pair<float, int3>> staleTiles;
 
 	//logGlobal->infoStream() << boost::format("Min dist for density %f is %d") % density % min_dist;
-	for(auto tile : possibleTiles)
+	//check tiles starting from the most distant ones, first suitable tile is the best one
+	for (auto it = tilesByDistance.rbegin(); it != tilesByDistance.rend() && !result; ++it)
 	{
-		auto dist = gen->getNearestObjectDistance(tile);
+		auto dist = it->first;
+		if (dist < min_dist || dist <= 0)
+			break;
 
-		if ((dist >= min_dist) && (dist > best_distance))
+		for (auto tile : it->second)
 		{
+			if (!possibleTiles.contains(tile))
+			{
+				staleTiles.push_back(std::make_pair(dist, tile));
+				continue;
+			}
+
 			bool allTilesAvailable = true;
 			gen->foreach_neighbour (tile, [&gen, &allTilesAvailable, needsGuard](int3 neighbour)
 			{
@@ -1943,12 +1988,14 @@ bool CRmgTemplateZone::findPlaceForTreasurePile(CMapGenerator* gen, float min_di
 			});
 			if (allTilesAvailable)
 			{
-				best_distance = dist;
 				pos = tile;
 				result = true;
+				break;
 			}
 		}
 	}
+	removeStaleDistanceTiles(staleTiles);
+
 	if (result)
 	{
 		gen->setOccupied(pos, ETileType::BLOCKED); //block that tile //FIXME: why?
@@ -2037,27 +2084,32 @@ bool CRmgTemplateZone::findPlaceForObject(CMapGenerator* gen, CGObjectInstance*
 	//we need object apperance to deduce free tile
 	setTemplateForObject(gen, obj);
 
-	int best_distance = 0;
 	bool result = false;
 
 	auto tilesBlockedByObject = obj->getBlockedOffsets();
 
-	for (auto tile : tileinfo)
+	//all possible tiles of zone are indexed by distance, check the most distant ones first
+	for (auto it = tilesByDistance.rbegin(); it != tilesByDistance.rend() && !result; ++it)
 	{
-		//object must be accessible from at least one surounding tile
-		if (!isAccessibleFromAnywhere(gen, obj->appearance, tile))
-			continue;
+		auto dist = it->first;
+		if (dist < min_dist || dist <= 0)
+			break;
 
-		auto ti = gen->getTile(tile);
-		auto dist = ti.getNearestObjectDistance();
-		//avoid borders
-		if (gen->isPossible(tile) && (dist >= min_dist) && (dist > best_distance))
+		for (auto tile : it->second)
 		{
+			//avoid borders
+			if (!gen->isPossible(tile))
+				continue;
+
+			//object must be accessible from at least one surounding tile
+			if (!isAccessibleFromAnywhere(gen, obj->appearance, tile))
+				continue;
+
 			if (areAllTilesAvailable(gen, obj, tile, tilesBlockedByObject))
 			{
-				best_distance = dist;
 				pos = tile;
 				result = true;
+				break;
 			}
 		}
 	}
@@ -2136,10 +2188,64 @@ void CRmgTemplateZone::placeObject(CMapGenerator* gen, CGObjectInstance* object,
 
 void CRmgTemplateZone::updateDistances(CMapGenerator* gen, const int3 & pos)
 {
-	for (auto tile : possibleTiles) //don't need to mark distance for not possible tiles
+	if (tilesByDistance.empty())
+		return;
+
+	auto updateTile = [this, gen, &pos](int3 tile)
+	{
+		if (!possibleTiles.contains(tile)) //don't need to mark distance for not possible tiles
+			return;
+
+		float d = pos.dist2dSQ(tile); //optimization, only relative distance is interesting
+		float current = gen->getNearestObjectDistance(tile);
+		if (d < current)
+		{
+			moveTileToDistance(tile, current, d);
+			gen->setNearestObjectDistance(tile, d);
+		}
+	};
+
+	//only tiles closer to new object than the most distant tile to any other object may change
+	int radius = std::sqrt(tilesByDistance.rbegin()->first) + 1;
+	if (ui64(2 * radius + 1) * (2 * radius + 1) >= possibleTiles.size())
+	{
+		for (auto tile : possibleTiles)
+			updateTile(tile);
+	}
+	else
+	{
+		for (int y = pos.y - radius; y <= pos.y + radius; y++)
+		{
+			for (int x = pos.x - radius; x <= pos.x + radius; x++)
+			{
+				int3 tile(x, y, getPos().z);
+				if (gen->map->isInTheMap(tile))
+					updateTile(tile);
+			}
+		}
+	}
+}
+
+void CRmgTemplateZone::moveTileToDistance(const int3 & tile, float oldDistance, float newDistance)
+{
+	auto it = tilesByDistance.find(oldDistance);
+	if (it != tilesByDistance.end())
 	{
-		ui32 d = pos.dist2dSQ(tile); //optimization, only relative distance is interesting
-		gen->setNearestObjectDistance(tile, std::min<float>(d, gen->getNearestObjectDistance(tile)));
+		it->second.erase(tile);
+		if (it->second.empty())
+			tilesByDistance.erase(it);
+	}
+	tilesByDistance[newDistance].insert(tile);
+}
+
+void CRmgTemplateZone::removeStaleDistanceTiles(const std::vector<std::pair<float, int3>> & staleTiles)
+{
+	for (auto & stale : staleTiles)
+	{
+		auto it = tilesByDistance.find(stale.first);
+		it->second.erase(stale.second);
+		if (it->second.empty())
+			tilesByDistance.erase(it);
 	}
 }
 
@@ -2368,7 +2474,7 @@ ObjectInfo CRmgTemplateZone::getRandomObject(CMapGenerator* gen, CTreasurePileIn
 	}
 	else
 	{
-		int r = gen->rand.nextInt (1, total);
+		int r = rand.nextInt (1, total);
 
 		//binary search = fastest
 		auto it = std::lower_bound(thresholds.begin(), thresholds.end(), r,
@@ -2439,7 +2545,7 @@ void CRmgTemplateZone::addAllPossibleObjects(CMapGenerator* gen)
 					possibleHeroes.push_back(j);
 			}
 
-			auto hid = *RandomGeneratorUtil::nextItem(possibleHeroes, gen->rand);
+			auto hid = *RandomGeneratorUtil::nextItem(possibleHeroes, rand);
 			auto factory = VLC->objtypeh->getHandlerFor(Obj::PRISON, 0);
 			auto obj = (CGHeroInstance *) factory->create(ObjectTemplate());
 
@@ -2493,7 +2599,7 @@ void CRmgTemplateZone::addAllPossibleObjects(CMapGenerator* gen)
 					oi.generateObject = [gen, temp, secondaryID, dwellingHandler]() -> CGObjectInstance *
 					{
 						auto obj = VLC->objtypeh->getHandlerFor(Obj::CREATURE_GENERATOR1, secondaryID)->create(temp);
-						//dwellingHandler->configureObject(obj, gen->rand);
+						//dwellingHandler->configureObject(obj, rand);
 						obj->tempOwner = PlayerColor::NEUTRAL;
 						return obj;
 					};
@@ -2509,7 +2615,7 @@ void CRmgTemplateZone::addAllPossibleObjects(CMapGenerator* gen)
 
 	for (int i = 0; i < 5; i++)
 	{
-		oi.generateObject = [i, gen]() -> CGObjectInstance *
+		oi.generateObject = [i, gen, this]() -> CGObjectInstance *
 		{
 			auto factory = VLC->objtypeh->getHandlerFor(Obj::SPELL_SCROLL, 0);
 			auto obj = (CGArtifact *) factory->create(ObjectTemplate());
@@ -2522,7 +2628,7 @@ void CRmgTemplateZone::addAllPossibleObjects(CMapGenerator* gen)
 					out.push_back(spell->id);
 				}
 			}
-			auto a = CArtifactInstance::createScroll(RandomGeneratorUtil::nextItem(out, gen->rand)->toSpell());
+			auto a = CArtifactInstance::createScroll(RandomGeneratorUtil::nextItem(out, rand)->toSpell());
 			obj->storedArtifact = a;
 			return obj;
 		};
@@ -2615,7 +2721,7 @@ void CRmgTemplateZone::addAllPossibleObjects(CMapGenerator* gen)
 	//Pandora with 12 spells of certain level
 	for (int i = 1; i <= GameConstants::SPELL_LEVELS; i++)
 	{
-		oi.generateObject = [i, gen]() -> CGObjectInstance *
+		oi.generateObject = [i, gen, this]() -> CGObjectInstance *
 		{
 			auto factory = VLC->objtypeh->getHandlerFor(Obj::PANDORAS_BOX, 0);
 			auto obj = (CGPandoraBox *) factory->create(ObjectTemplate());
@@ -2627,7 +2733,7 @@ void CRmgTemplateZone::addAllPossibleObjects(CMapGenerator* gen)
 					spells.push_back(spell);
 			}
 
-			RandomGeneratorUtil::randomShuffle(spells, gen->rand);
+			RandomGeneratorUtil::randomShuffle(spells, rand);
 			for (int j = 0; j < std::min<int>(12, spells.size()); j++)
 			{
 				obj->spells.push_back(spells[j]->id);
@@ -2644,7 +2750,7 @@ void CRmgTemplateZone::addAllPossibleObjects(CMapGenerator* gen)
 	//Pandora with 15 spells of certain school
 	for (int i = 0; i < 4; i++)
 	{
-		oi.generateObject = [i,gen]() -> CGObjectInstance *
+		oi.generateObject = [i, gen, this]() -> CGObjectInstance *
 		{
 			auto factory = VLC->objtypeh->getHandlerFor(Obj::PANDORAS_BOX, 0);
 			auto obj = (CGPandoraBox *) factory->create(ObjectTemplate());
@@ -2657,7 +2763,7 @@ void CRmgTemplateZone::addAllPossibleObjects(CMapGenerator* gen)
 					spells.push_back(spell);
 			}
 
-			RandomGeneratorUtil::randomShuffle(spells, gen->rand);
+			RandomGeneratorUtil::randomShuffle(spells, rand);
 			for (int j = 0; j < std::min<int>(15, spells.size()); j++)
 			{
 				obj->spells.push_back(spells[j]->id);
@@ -2673,7 +2779,7 @@ void CRmgTemplateZone::addAllPossibleObjects(CMapGenerator* gen)
 
 	// Pandora box with 60 random spells
 
-	oi.generateObject = [gen]() -> CGObjectInstance *
+	oi.generateObject = [gen, this]() -> CGObjectInstance *
 	{
 		auto factory = VLC->objtypeh->getHandlerFor(Obj::PANDORAS_BOX, 0);
 		auto obj = (CGPandoraBox *) factory->create(ObjectTemplate());
@@ -2685,7 +2791,7 @@ void CRmgTemplateZone::addAllPossibleObjects(CMapGenerator* gen)
 				spells.push_back(spell);
 		}
 
-		RandomGeneratorUtil::randomShuffle(spells, gen->rand);
+		RandomGeneratorUtil::randomShuffle(spells, rand);
 		for (int j = 0; j < std::min<int>(60, spells.size()); j++)
 		{
 			obj->spells.push_back(spells[j]->id);
@@ -2718,7 +2824,7 @@ void CRmgTemplateZone::addAllPossibleObjects(CMapGenerator* gen)
 		}
 		oi.maxPerZone = seerHutsPerType;
 
-		RandomGeneratorUtil::randomShuffle(creatures, gen->rand);
+		RandomGeneratorUtil::randomShuffle(creatures, rand);
 
 		auto generateArtInfo = [this](ArtifactID id) -> ObjectInfo
 		{
@@ -2743,7 +2849,7 @@ void CRmgTemplateZone::addAllPossibleObjects(CMapGenerator* gen)
 			if (!creaturesAmount)
 				continue;
 
-			int randomAppearance = *RandomGeneratorUtil::nextItem(VLC->objtypeh->knownSubObjects(Obj::SEER_HUT), gen->rand);
+			int randomAppearance = *RandomGeneratorUtil::nextItem(VLC->objtypeh->knownSubObjects(Obj::SEER_HUT), rand);
 
 			oi.generateObject = [creature, creaturesAmount, randomAppearance, gen, this, generateArtInfo]() -> CGObjectInstance *
 			{
@@ -2754,7 +2860,7 @@ void CRmgTemplateZone::addAllPossibleObjects(CMapGenerator* gen)
 				obj->rVal = creaturesAmount;
 
 				obj->quest->missionType = CQuest::MISSION_ART;
-				ArtifactID artid = *RandomGeneratorUtil::nextItem(gen->getQuestArtsRemaning(), gen->rand);
+				ArtifactID artid = *RandomGeneratorUtil::nextItem(gen->getQuestArtsRemaning(), rand);
 				obj->quest->m5arts.push_back(artid);
 				obj->quest->lastDay = -1;
 				obj->quest->isCustomFirst = obj->quest->isCustomNext = obj->quest->isCustomComplete = false;
@@ -2776,7 +2882,7 @@ void CRmgTemplateZone::addAllPossibleObjects(CMapGenerator* gen)
 
 		for (int i = 0; i < 4; i++) //seems that code for exp and gold reward is similiar
 		{
-			int randomAppearance = *RandomGeneratorUtil::nextItem(VLC->objtypeh->knownSubObjects(Obj::SEER_HUT), gen->rand);
+			int randomAppearance = *RandomGeneratorUtil::nextItem(VLC->objtypeh->knownSubObjects(Obj::SEER_HUT), rand);
 
 			oi.setTemplate(Obj::SEER_HUT, randomAppearance, terrainType);
 			oi.value = seerValues[i];
@@ -2792,7 +2898,7 @@ void CRmgTemplateZone::addAllPossibleObjects(CMapGenerator* gen)
 				obj->rVal = seerExpGold[i];
 
 				obj->quest->missionType = CQuest::MISSION_ART;
-				ArtifactID artid = *RandomGeneratorUtil::nextItem(gen->getQuestArtsRemaning(), gen->rand);
+				ArtifactID artid = *RandomGeneratorUtil::nextItem(gen->getQuestArtsRemaning(), rand);
 				obj->quest->m5arts.push_back(artid);
 				obj->quest->lastDay = -1;
 				obj->quest->isCustomFirst = obj->quest->isCustomNext = obj->quest->isCustomComplete = false;
@@ -2815,7 +2921,7 @@ void CRmgTemplateZone::addAllPossibleObjects(CMapGenerator* gen)
 				obj->rVal = seerExpGold[i];
 
 				obj->quest->missionType = CQuest::MISSION_ART;
-				ArtifactID artid = *RandomGeneratorUtil::nextItem(gen->getQuestArtsRemaning(), gen->rand);
+				ArtifactID artid = *RandomGeneratorUtil::nextItem(gen->getQuestArtsRemaning(), rand);
 				obj->quest->m5arts.push_back(artid);
 				obj->quest->lastDay = -1;
 				obj->quest->isCustomFirst = obj->quest->isCustomNext = obj->quest->isCustomComplete = false;
@@ -17,6 +17,7 @@
 #include "../int3.h"
 #include "../ResourceSet.h" //for TResource (?)
 #include "../mapObjects/ObjectTemplate.h"
+#include "CTileSet.h"
 #include <boost/heap/priority_queue.hpp> //A*
 
 class CMapGenerator;
@@ -128,6 +129,8 @@ public:
 	};
 
 	CRmgTemplateZone();
+	/// Copies description of the zone from template, without any state of map generation
+	CRmgTemplateZone(const CRmgTemplateZone & other);
 
 	TRmgTemplateZoneId getId() const; /// Default: 0
 	void setId(TRmgTemplateZoneId value);
@@ -155,6 +158,7 @@ public:
 	void setMinesAmount (TResource res, ui16 amount);
 	std::map<TResource, ui16> getMinesInfo() const;
 	void setMonsterStrength (EMonsterStrength::EMonsterStrength val);
+	void setRandomSeed(int seed);
 
 	float3 getCenter() const;
 	void setCenter(const float3 &f);
@@ -165,8 +169,8 @@ public:
 
 	void addTile (const int3 &pos);
 	void initFreeTiles (CMapGenerator* gen);
-	std::set<int3> getTileInfo() const;
-	std::set<int3> getPossibleTiles() const;
+	const CTileSet & getTileInfo() const;
+	const CTileSet & getPossibleTiles() const;
 	void discardDistantTiles (CMapGenerator* gen, float distance);
 	void clearTiles();
 
@@ -175,6 +179,7 @@ public:
 	void addToConnectLater(const int3& src);
 	bool addMonster(CMapGenerator* gen, int3 &pos, si32 strength, bool clearSurroundingTiles = true, bool zoneGuard = false);
 	bool createTreasurePile(CMapGenerator* gen, int3 &pos, float minDistance, const CTreasureInfo& treasureInfo);
+	void createPaths (CMapGenerator* gen); //touches only tiles of this zone, may run concurrently for different zones
 	bool fill (CMapGenerator* gen);
 	bool placeMines (CMapGenerator* gen);
 	void initTownType (CMapGenerator* gen);
@@ -189,7 +194,7 @@ public:
 	void createTreasures(CMapGenerator* gen);
 	void createObstacles1(CMapGenerator* gen);
 	void createObstacles2(CMapGenerator* gen);
-	bool crunchPath(CMapGenerator* gen, const int3 &src, const int3 &dst, bool onlyStraight, std::set<int3>* clearedTiles = nullptr);
+	bool crunchPath(CMapGenerator* gen, const int3 &src, const int3 &dst, bool onlyStraight, CTileSet* clearedTiles = nullptr);
 	bool connectPath(CMapGenerator* gen, const int3& src, bool onlyStraight);
 	bool connectWithCenter(CMapGenerator* gen, const int3& src, bool onlyStraight);
 	void updateDistances(CMapGenerator* gen, const int3 & pos);
@@ -202,7 +207,7 @@ public:
 	std::vector<TRmgTemplateZoneId> getConnections() const;
 	void addTreasureInfo(CTreasureInfo & info);
 	std::vector<CTreasureInfo> getTreasureInfo();
-	std::set<int3>* getFreePaths();
+	CTileSet* getFreePaths();
 
 	ObjectInfo getRandomObject (CMapGenerator* gen, CTreasurePileInfo &info, ui32 desiredValue, ui32 maxValue, ui32 currentValue);
 
@@ -241,6 +246,7 @@ private:
 	si32 townType;
 	ETerrainType terrainType;
 	CRmgTemplateZone * questArtZone; //artifacts required for Seer Huts will be placed here - or not if null
+	CRandomGenerator rand; //seeded by generator for every map, independent from other zones
 
 	EMonsterStrength::EMonsterStrength zoneMonsterStrength;
 	std::vector<CTreasureInfo> treasureInfo;
@@ -255,16 +261,19 @@ private:
 	//placement info
 	int3 pos;
 	float3 center;
-	std::set<int3> tileinfo; //irregular area assined to zone
-	std::set<int3> possibleTiles; //optimization purposes for treasure generation
+	CTileSet tileinfo; //irregular area assined to zone
+	CTileSet possibleTiles; //optimization purposes for treasure generation
 	std::vector<TRmgTemplateZoneId> connections; //list of adjacent zones
-	std::set<int3> freePaths; //core paths of free tiles that all other objects will be linked to
+	CTileSet freePaths; //core paths of free tiles that all other objects will be linked to
 
-	std::set<int3> roadNodes; //tiles to be connected with roads
-	std::set<int3> roads; //all tiles with roads
-	std::set<int3> tilesToConnectLater; //will be connected after paths are fractalized
+	CTileSet roadNodes; //tiles to be connected with roads
+	CTileSet roads; //all tiles with roads
+	CTileSet tilesToConnectLater; //will be connected after paths are fractalized
+	std::map<float, std::set<int3>> tilesByDistance; //possible tiles grouped by squared distance to nearest object, may contain tiles that are no longer possible
 
 	bool createRoad(CMapGenerator* gen, const int3 &src, const int3 &dst);
+	void moveTileToDistance(const int3 & tile, float oldDistance, float newDistance);
+	void removeStaleDistanceTiles(const std::vector<std::pair<float, int3>> & staleTiles);
 	void drawRoads(CMapGenerator * gen); //actually updates tiles
 
 	bool pointIsIn(int x, int y);
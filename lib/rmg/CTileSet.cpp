@@ -0,0 +1,240 @@
+/*
+ * CTileSet.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "CTileSet.h"
+
+CTileSet::const_iterator::const_iterator() : owner(nullptr), index(0)
+{
+}
+
+CTileSet::const_iterator::const_iterator(const CTileSet * owner, size_t index) : owner(owner), index(index)
+{
+}
+
+int3 CTileSet::const_iterator::operator*() const
+{
+	return owner->fromIndex(index);
+}
+
+CTileSet::const_iterator & CTileSet::const_iterator::operator++()
+{
+	index = owner->nextIndex(index + 1);
+	return *this;
+}
+
+CTileSet::const_iterator CTileSet::const_iterator::operator++(int)
+{
+	const_iterator ret = *this;
+	++(*this);
+	return ret;
+}
+
+CTileSet::const_iterator & CTileSet::const_iterator::operator--()
+{
+	index = owner->prevIndex(index);
+	return *this;
+}
+
+CTileSet::const_iterator CTileSet::const_iterator::operator--(int)
+{
+	const_iterator ret = *this;
+	--(*this);
+	return ret;
+}
+
+CTileSet::CTileSet() : origin(0, 0, 0), width(0), height(0), levels(0), tilesCount(0), firstIndex(0), lastIndex(0)
+{
+}
+
+bool CTileSet::insert(const int3 & tile)
+{
+	if (!isInside(tile))
+		grow(tile);
+
+	size_t index = toIndex(tile);
+	TWord mask = TWord(1) << (index % WORD_BITS);
+	TWord & word = bits[index / WORD_BITS];
+	if (word & mask)
+		return false;
+
+	word |= mask;
+	if (tilesCount == 0)
+	{
+		firstIndex = index;
+		lastIndex = index;
+	}
+	else
+	{
+		vstd::amin(firstIndex, index);
+		vstd::amax(lastIndex, index);
+	}
+	tilesCount++;
+	return true;
+}
+
+size_t CTileSet::erase(const int3 & tile)
+{
+	if (!isInside(tile))
+		return 0;
+
+	size_t index = toIndex(tile);
+	TWord mask = TWord(1) << (index % WORD_BITS);
+	TWord & word = bits[index / WORD_BITS];
+	if (!(word & mask))
+		return 0;
+
+	word &= ~mask;
+	tilesCount--;
+	return 1;
+}
+
+bool CTileSet::contains(const int3 & tile) const
+{
+	return isInside(tile) && test(toIndex(tile));
+}
+
+void CTileSet::clear()
+{
+	if (tilesCount)
+		std::fill(bits.begin() + firstIndex / WORD_BITS, bits.begin() + lastIndex / WORD_BITS + 1, 0);
+	tilesCount = 0;
+	firstIndex = 0;
+	lastIndex = 0;
+}
+
+size_t CTileSet::size() const
+{
+	return tilesCount;
+}
+
+bool CTileSet::empty() const
+{
+	return tilesCount == 0;
+}
+
+CTileSet::const_iterator CTileSet::begin() const
+{
+	return const_iterator(this, nextIndex(firstIndex));
+}
+
+CTileSet::const_iterator CTileSet::end() const
+{
+	return const_iterator(this, capacity());
+}
+
+size_t CTileSet::capacity() const
+{
+	return size_t(width) * height * levels;
+}
+
+bool CTileSet::isInside(const int3 & tile) const
+{
+	const int3 pos = tile - origin;
+	return pos.x >= 0 && pos.y >= 0 && pos.z >= 0 && pos.x < width && pos.y < height && pos.z < levels;
+}
+
+size_t CTileSet::toIndex(const int3 & tile) const
+{
+	//same order as int3::operator<, so iteration order matches std::set<int3>
+	const int3 pos = tile - origin;
+	return (size_t(pos.z) * height + pos.y) * width + pos.x;
+}
+
+int3 CTileSet::fromIndex(size_t index) const
+{
+	return origin + int3(index % width, (index / width) % height, index / (size_t(width) * height));
+}
+
+bool CTileSet::test(size_t index) const
+{
+	return (bits[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+}
+
+void CTileSet::grow(const int3 & tile)
+{
+	std::vector<int3> tiles(begin(), end());
+
+	//grow geometrically, tiles are usually added row by row
+	if (tile.x < origin.x)
+	{
+		const int newX = std::min(tile.x, origin.x - width);
+		width += origin.x - newX;
+		origin.x = newX;
+	}
+	if (tile.y < origin.y)
+	{
+		const int newY = std::min(tile.y, origin.y - height);
+		height += origin.y - newY;
+		origin.y = newY;
+	}
+	if (tile.z < origin.z)
+	{
+		levels += origin.z - tile.z;
+		origin.z = tile.z;
+	}
+	if (tile.x >= origin.x + width)
+		width = std::max(tile.x - origin.x + 1, width * 2);
+	if (tile.y >= origin.y + height)
+		height = std::max(tile.y - origin.y + 1, height * 2);
+	if (tile.z >= origin.z + levels)
+		levels = tile.z - origin.z + 1;
+
+	bits.assign((capacity() + WORD_BITS - 1) / WORD_BITS, 0);
+	tilesCount = 0;
+	for (auto & t : tiles)
+		insert(t);
+}
+
+size_t CTileSet::nextIndex(size_t from) const
+{
+	if (tilesCount == 0 || from > lastIndex)
+		return capacity();
+	vstd::amax(from, firstIndex);
+
+	size_t wordIndex = from / WORD_BITS;
+	TWord word = bits[wordIndex] & (~TWord(0) << (from % WORD_BITS));
+	const size_t lastWord = lastIndex / WORD_BITS;
+
+	while (!word)
+	{
+		if (++wordIndex > lastWord)
+			return capacity();
+		word = bits[wordIndex];
+	}
+
+	size_t bit = 0;
+	while (!((word >> bit) & 1))
+		bit++;
+	return wordIndex * WORD_BITS + bit;
+}
+
+size_t CTileSet::prevIndex(size_t before) const
+{
+	assert(tilesCount);
+	vstd::amin(before, lastIndex + 1);
+	assert(before > firstIndex);
+
+	size_t last = before - 1;
+	size_t wordIndex = last / WORD_BITS;
+	size_t shift = WORD_BITS - 1 - last % WORD_BITS;
+	TWord word = bits[wordIndex] & (~TWord(0) >> shift);
+
+	while (!word)
+	{
+		assert(wordIndex > firstIndex / WORD_BITS);
+		word = bits[--wordIndex];
+	}
+
+	size_t bit = WORD_BITS - 1;
+	while (!((word >> bit) & 1))
+		bit--;
+	return wordIndex * WORD_BITS + bit;
+}
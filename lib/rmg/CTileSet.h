@@ -0,0 +1,88 @@
+/*
+ * CTileSet.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#pragma once
+
+#include "../int3.h"
+
+/// Set of map tiles stored as a bitmap over the map area. Insertion, removal and lookup take
+/// constant time and tiles are iterated in the same order as in std::set<int3>.
+/// Bitmap grows on demand in every direction, including negative coordinates.
+/// Erasing tiles does not invalidate iterators, inserting new tiles may do so.
+class DLL_LINKAGE CTileSet
+{
+public:
+	class DLL_LINKAGE const_iterator
+	{
+	public:
+		typedef std::bidirectional_iterator_tag iterator_category;
+		typedef int3 value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const int3 * pointer;
+		typedef int3 reference;
+
+		const_iterator();
+
+		int3 operator*() const;
+		const_iterator & operator++();
+		const_iterator operator++(int);
+		const_iterator & operator--();
+		const_iterator operator--(int);
+
+		bool operator==(const const_iterator & other) const { return index == other.index; }
+		bool operator!=(const const_iterator & other) const { return index != other.index; }
+
+	private:
+		friend class CTileSet;
+		const_iterator(const CTileSet * owner, size_t index);
+
+		const CTileSet * owner;
+		size_t index;
+	};
+
+	typedef const_iterator iterator;
+	typedef int3 value_type;
+	typedef size_t size_type;
+
+	CTileSet();
+
+	/// returns true if tile was not present in set
+	bool insert(const int3 & tile);
+	/// returns number of removed tiles (0 or 1)
+	size_t erase(const int3 & tile);
+	bool contains(const int3 & tile) const;
+	void clear();
+
+	size_t size() const;
+	bool empty() const;
+
+	const_iterator begin() const;
+	const_iterator end() const;
+
+private:
+	typedef ui64 TWord;
+	static const size_t WORD_BITS = 64;
+
+	std::vector<TWord> bits;
+	int3 origin; //coordinates of first bit
+	int width, height, levels;
+	size_t tilesCount;
+	size_t firstIndex, lastIndex; //range that may contain tiles
+
+	size_t capacity() const;
+	bool isInside(const int3 & tile) const;
+	size_t toIndex(const int3 & tile) const;
+	int3 fromIndex(size_t index) const;
+	bool test(size_t index) const;
+	void grow(const int3 & tile);
+
+	size_t nextIndex(size_t from) const; //first tile at or after from, capacity() if none
+	size_t prevIndex(size_t before) const; //last tile before given index
+};
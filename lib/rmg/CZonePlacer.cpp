@@ -484,7 +484,7 @@ void CZonePlacer::assignZones(const CMapGenOptions * mapGenOptions)
 	auto moveZoneToCenterOfMass = [](CRmgTemplateZone * zone) -> void
 	{
 		int3 total(0, 0, 0);
-		auto tiles = zone->getTileInfo();
+		const auto & tiles = zone->getTileInfo();
 		for (auto tile : tiles)
 		{
 			total += tile;
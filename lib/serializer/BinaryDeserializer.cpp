@@ -3,6 +3,8 @@
 
 #include "../registerTypes/RegisterTypes.h"
 
+#include <zlib.h>
+
 /*
  * BinaryDeserializer.cpp, part of VCMI engine
  *
@@ -16,7 +18,7 @@
 extern template void registerTypes<BinaryDeserializer>(BinaryDeserializer & s);
 
 CLoadFile::CLoadFile(const boost::filesystem::path & fname, int minimalVersion /*= version*/)
-	: serializer(this)
+	: serializer(this), compressed(false), chunkPos(0)
 {
 	registerTypes(serializer);
 	openNextFile(fname, minimalVersion);
@@ -28,10 +30,51 @@ CLoadFile::~CLoadFile()
 
 int CLoadFile::read(void * data, unsigned size)
 {
-	sfile->read((char*)data,size);
+	if(!compressed)
+	{
+		sfile->read((char*)data,size);
+		return size;
+	}
+
+	auto out = static_cast<ui8 *>(data);
+	unsigned done = 0;
+	while(done < size)
+	{
+		if(chunkPos == chunk.size())
+			readNextChunk();
+
+		size_t toCopy = std::min<size_t>(size - done, chunk.size() - chunkPos);
+		std::copy(chunk.begin() + chunkPos, chunk.begin() + chunkPos + toCopy, out + done);
+		chunkPos += toCopy;
+		done += toCopy;
+	}
 	return size;
 }
 
+void CLoadFile::readNextChunk()
+{
+	ui32 header[2]; //decompressed and compressed size
+	sfile->read((char*)header, sizeof(header));
+	if(serializer.reverseEndianess)
+	{
+		for(ui32 & field : header)
+			std::reverse((char*)&field, (char*)&field + sizeof(field));
+	}
+
+	//sizes come from file, check them before allocating anything
+	if(header[0] == 0 || header[0] > COMPRESSED_CHUNK_SIZE || header[1] > compressBound(header[0]))
+		THROW_FORMAT("Error: invalid chunk header in %s!", fName);
+
+	std::vector<ui8> compressedData(header[1]);
+	sfile->read((char*)compressedData.data(), compressedData.size());
+
+	chunk.resize(header[0]);
+	chunkPos = 0;
+	uLongf decompressedSize = chunk.size();
+	if(uncompress(chunk.data(), &decompressedSize, compressedData.data(), compressedData.size()) != Z_OK || decompressedSize != chunk.size())
+		THROW_FORMAT("Error: corrupted chunk in %s!", fName);
+}
+
 void CLoadFile::openNextFile(const boost::filesystem::path & fname, int minimalVersion)
 {
 	assert(!serializer.reverseEndianess);
@@ -40,6 +83,9 @@ void CLoadFile::openNextFile(const boost::filesystem::path & fname, int minimalV
 	try
 	{
 		fName = fname.string();
+		compressed = false;
+		chunk.clear();
+		chunkPos = 0;
 		sfile = make_unique<FileStream>(fname, std::ios::in | std::ios::binary);
 		sfile->exceptions(std::ifstream::failbit | std::ifstream::badbit); //we throw a lot anyway
 
@@ -49,7 +95,8 @@ void CLoadFile::openNextFile(const boost::filesystem::path & fname, int minimalV
 		//we can read
 		char buffer[4];
 		sfile->read(buffer, 4);
-		if(std::memcmp(buffer,"VCMI",4))
+		bool compressedFile = !std::memcmp(buffer, COMPRESSED_FILE_MAGIC.c_str(), 4);
+		if(std::memcmp(buffer,"VCMI",4) && !compressedFile)
 			THROW_FORMAT("Error: not a VCMI file(%s)!", fName);
 
 		serializer & serializer.fileVersion;
@@ -72,6 +119,7 @@ void CLoadFile::openNextFile(const boost::filesystem::path & fname, int minimalV
 			else
 				THROW_FORMAT("Error: too new file format (%s)!", fName);
 		}
+		compressed = compressedFile; //everything after format version is in chunks
 	}
 	catch(...)
 	{
@@ -94,6 +142,9 @@ void CLoadFile::clear()
 	sfile = nullptr;
 	fName.clear();
 	serializer.fileVersion = 0;
+	compressed = false;
+	chunk.clear();
+	chunkPos = 0;
 }
 
 void CLoadFile::checkMagicBytes(const std::string &text)
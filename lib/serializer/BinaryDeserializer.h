@@ -517,11 +517,16 @@ public:
 	std::string fName;
 	std::unique_ptr<FileStream> sfile;
 
+	bool compressed; //file is divided into compressed chunks, decompressed one by one while reading
+	std::vector<ui8> chunk; //decompressed data of current chunk
+	size_t chunkPos;
+
 	CLoadFile(const boost::filesystem::path & fname, int minimalVersion = SERIALIZATION_VERSION); //throws!
 	~CLoadFile();
 	int read(void * data, unsigned size) override; //throws!
 
 	void openNextFile(const boost::filesystem::path & fname, int minimalVersion); //throws!
+	void readNextChunk(); //throws!
 	void clear();
 	void reportState(CLogger * out) override;
 
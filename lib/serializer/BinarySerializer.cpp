@@ -2,6 +2,9 @@
 #include "BinarySerializer.h"
 
 #include "../registerTypes/RegisterTypes.h"
+#include "../CThreadHelper.h"
+
+#include <zlib.h>
 
 /*
  * BinarySerializer.cpp, part of VCMI engine
@@ -73,3 +76,128 @@ void CSaveFile::putMagicBytes(const std::string &text)
 {
 	write(text.c_str(), text.length());
 }
+
+static boost::mutex backgroundWritesMx;
+static boost::condition_variable backgroundWritesCv;
+static ui32 scheduledWrites = 0; //tickets given to writer threads
+static ui32 finishedWrites = 0; //threads write in order of their tickets
+
+static void writeChunks(FileStream & file, const std::vector<ui8> & data, std::vector<size_t> chunkEnds)
+{
+	chunkEnds.push_back(data.size());
+	std::vector<ui8> compressed;
+	size_t start = 0;
+	for(size_t end : chunkEnds)
+	{
+		while(start < end)
+		{
+			ui32 size = std::min<size_t>(end - start, COMPRESSED_CHUNK_SIZE);
+			uLongf compressedSize = compressBound(size);
+			compressed.resize(compressedSize);
+			if(compress2(compressed.data(), &compressedSize, data.data() + start, size, Z_DEFAULT_COMPRESSION) != Z_OK)
+				throw std::runtime_error("Failed to compress chunk of savegame!");
+
+			ui32 header[2] = {size, static_cast<ui32>(compressedSize)};
+			file.write(reinterpret_cast<const char *>(header), sizeof(header));
+			file.write(reinterpret_cast<const char *>(compressed.data()), compressedSize);
+			start += size;
+		}
+	}
+}
+
+CBackgroundSaveFile::CBackgroundSaveFile(const boost::filesystem::path &fname, bool compress)
+	: serializer(this), fName(fname), compressed(compress), buffer(std::make_shared<std::vector<ui8>>())
+{
+	registerTypes(serializer);
+}
+
+CBackgroundSaveFile::~CBackgroundSaveFile()
+{
+}
+
+int CBackgroundSaveFile::write(const void * data, unsigned size)
+{
+	auto bytes = static_cast<const ui8 *>(data);
+	buffer->insert(buffer->end(), bytes, bytes + size);
+	return size;
+}
+
+void CBackgroundSaveFile::reportState(CLogger * out)
+{
+	out->debugStream() << "CBackgroundSaveFile";
+	out->debugStream() << "\tSaving " << fName << "\n\tBuffered: " << buffer->size();
+}
+
+void CBackgroundSaveFile::putMagicBytes(const std::string &text)
+{
+	write(text.c_str(), text.length());
+}
+
+void CBackgroundSaveFile::finishChunk()
+{
+	chunkEnds.push_back(buffer->size());
+}
+
+void CBackgroundSaveFile::writeInBackground()
+{
+	ui32 ticket;
+	{
+		boost::unique_lock<boost::mutex> lock(backgroundWritesMx);
+		ticket = scheduledWrites++;
+	}
+
+	auto data = buffer;
+	auto path = fName;
+	auto compress = compressed;
+	auto chunks = chunkEnds;
+	boost::thread([=]()
+	{
+		setThreadName("CBackgroundSaveFile::writeInBackground");
+		{
+			boost::unique_lock<boost::mutex> lock(backgroundWritesMx);
+			while(finishedWrites != ticket)
+				backgroundWritesCv.wait(lock);
+		}
+
+		auto tempPath = path;
+		tempPath += ".tmp";
+		try
+		{
+			{
+				FileStream file(tempPath, std::ios::out | std::ios::binary);
+				file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+				const std::string magic = compress ? COMPRESSED_FILE_MAGIC : "VCMI";
+				file.write(magic.c_str(), magic.length()); //write magic identifier
+				file.write(reinterpret_cast<const char *>(&SERIALIZATION_VERSION), sizeof(SERIALIZATION_VERSION)); //write format version
+
+				if(compress)
+					writeChunks(file, *data, chunks);
+				else
+					file.write(reinterpret_cast<const char *>(data->data()), data->size());
+			}
+			boost::filesystem::rename(tempPath, path);
+			logGlobal->info("Saved %s (%d bytes)", path.string(), data->size());
+		}
+		catch(std::exception & e)
+		{
+			logGlobal->error("Failed to save to %s: %s", path.string(), e.what());
+			boost::system::error_code ec;
+			boost::filesystem::remove(tempPath, ec);
+		}
+
+		boost::unique_lock<boost::mutex> lock(backgroundWritesMx);
+		finishedWrites++;
+		backgroundWritesCv.notify_all();
+	}).detach();
+
+	buffer = std::make_shared<std::vector<ui8>>();
+	chunkEnds.clear();
+}
+
+void CBackgroundSaveFile::waitForPendingWrites()
+{
+	boost::unique_lock<boost::mutex> lock(backgroundWritesMx);
+	while(finishedWrites != scheduledWrites)
+		backgroundWritesCv.wait(lock);
+}
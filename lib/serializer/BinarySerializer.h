@@ -363,6 +363,7 @@ public:
 	void reportState(CLogger * out) override;
 
 	void putMagicBytes(const std::string &text);
+	void finishChunk() {} //raw file is not divided into chunks
 
 	template<class T>
 	CSaveFile & operator<<(const T &t)
@@ -371,3 +372,38 @@ public:
 		return * this;
 	}
 };
+
+/// Serializes into memory, so game may continue while file is written by background thread.
+/// File is written under temporary name and renamed when complete, so an interrupted write never damages existing save.
+/// Optionally file is divided into zlib-compressed chunks, compression is done by background thread as well.
+class DLL_LINKAGE CBackgroundSaveFile : public IBinaryWriter
+{
+public:
+	BinarySerializer serializer;
+
+	boost::filesystem::path fName;
+	bool compressed;
+	std::shared_ptr<std::vector<ui8>> buffer;
+	std::vector<size_t> chunkEnds;
+
+	CBackgroundSaveFile(const boost::filesystem::path &fname, bool compress = false);
+	~CBackgroundSaveFile();
+	int write(const void * data, unsigned size) override;
+	void reportState(CLogger * out) override;
+
+	void putMagicBytes(const std::string &text);
+	/// data written so far will be stored in separate chunks, so that it can be read without decompressing rest of file
+	void finishChunk();
+
+	/// hands serialized data to writer thread, files are written in order in which they were scheduled
+	void writeInBackground();
+	/// blocks until all scheduled files are written
+	static void waitForPendingWrites();
+
+	template<class T>
+	CBackgroundSaveFile & operator<<(const T &t)
+	{
+		serializer & t;
+		return * this;
+	}
+};
@@ -17,6 +17,10 @@
 const ui32 SERIALIZATION_VERSION = 762;
 const ui32 MINIMAL_SERIALIZATION_VERSION = 753;
 const std::string SAVEGAME_MAGIC = "VCMISVG";
+//files starting with this identifier instead of "VCMI" are divided into zlib-compressed chunks:
+//[ui32 decompressed size][ui32 compressed size][compressed data]
+const std::string COMPRESSED_FILE_MAGIC = "VCMZ";
+const ui32 COMPRESSED_CHUNK_SIZE = 1024 * 1024;
 
 class CHero;
 class CGHeroInstance;
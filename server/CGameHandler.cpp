@@ -24,6 +24,7 @@
 #include "../lib/VCMIDirs.h"
 #include "../lib/ScopeGuard.h"
 #include "../lib/CSoundBase.h"
+#include "../lib/CConfigHandler.h"
 #include "CGameHandler.h"
 #include "CVCMIServer.h"
 #include "../lib/CCreatureSet.h"
@@ -116,6 +117,13 @@ public:
 
 static CApplier<CBaseForGHApply> *applier = nullptr;
 
+static void keepRequestSender(PlayerColor *)
+{
+	//sender is stored on stack of connection thread while its request is applied
+}
+
+static boost::thread_specific_ptr<PlayerColor> requestSender(&keepRequestSender);
+
 CMP_stack cmpst ;
 
 static inline double distance(int3 a, int3 b)
@@ -926,6 +934,59 @@ void CGameHandler::applyBattleEffects(BattleAttack &bat, const CStack *att, cons
 		bat.bsa.push_back(bsa2);
 	}
 }
+void CGameHandler::applyRequest(const CSimultaneousTurns::Request &request)
+{
+	CConnection &c = *request.connection;
+	CPack *pack = request.pack;
+
+	//prepare struct informing that action was applied
+	auto sendPackageResponse = [&](bool succesfullyApplied)
+	{
+		PackageApplied applied;
+		applied.player = request.player;
+		applied.result = succesfullyApplied;
+		applied.packType = request.packType;
+		applied.requestID = request.requestID;
+		boost::unique_lock<boost::mutex> lock(*c.wmx);
+		c << &applied;
+	};
+	PlayerColor sender = request.player;
+	requestSender.reset(&sender);
+	auto resetSender = vstd::makeScopeGuard([&]{ requestSender.release(); });
+
+	CBaseForGHApply *apply = applier->getApplier(request.packType); //and appropriate applier object
+	if(isBlockedByQueries(pack, request.player))
+	{
+		sendPackageResponse(false);
+	}
+	else if (apply)
+	{
+		const bool result = apply->applyOnGH(this, &c, pack, request.player);
+		if (result)
+			logGlobal->trace("Message %s successfully applied!", typeid(*pack).name());
+		else
+			complain((boost::format("Got false in applying %s... that request must have been fishy!")
+				% typeid(*pack).name()).str());
+
+		sendPackageResponse(true);
+	}
+	else
+	{
+		logGlobal->error("Message cannot be applied, cannot find applier (unregistered type)!");
+		sendPackageResponse(false);
+	}
+
+	vstd::clear_pointer(pack);
+}
+
+void CGameHandler::applyReadyRequests()
+{
+	boost::unique_lock<boost::mutex> lock(simultaneousTurns.applyMx);
+	CSimultaneousTurns::Request request;
+	while(simultaneousTurns.takeReadyRequest(request))
+		applyRequest(request);
+}
+
 void CGameHandler::handleConnection(std::set<PlayerColor> players, CConnection &c)
 {
 	setThreadName("CGameHandler::handleConnection");
@@ -934,62 +995,40 @@ void CGameHandler::handleConnection(std::set<PlayerColor> players, CConnection &
 	{
 		while(1)//server should never shut connection first //was: while(!end2)
 		{
-			CPack *pack = nullptr;
-			PlayerColor player = PlayerColor::NEUTRAL;
-			si32 requestID = -999;
-			int packType = 0;
+			CSimultaneousTurns::Request request;
+			request.pack = nullptr;
+			request.player = PlayerColor::NEUTRAL;
+			request.requestID = -999;
+			request.packType = 0;
+			request.connection = &c;
 
 			{
 				boost::unique_lock<boost::mutex> lock(*c.rmx);
-				c >> player >> requestID >> pack; //get the package
+				c >> request.player >> request.requestID >> request.pack; //get the package
 
-				if (!pack)
+				if (!request.pack)
 				{
-					logGlobal->error("Received a null package marked as request %d from player %d", requestID, player);
+					logGlobal->error("Received a null package marked as request %d from player %d", request.requestID, request.player);
 				}
 				else
 				{
-					packType = typeList.getTypeID(pack); //get the id of type
+					request.packType = typeList.getTypeID(request.pack); //get the id of type
 
 					logGlobal->trace("Received client message (request %d by player %d (%s)) of type with ID=%d (%s).\n",
-									 requestID, player, player.getStr(), packType, typeid(*pack).name());
+									 request.requestID, request.player, request.player.getStr(), request.packType, typeid(*request.pack).name());
 				}
 			}
 
-			//prepare struct informing that action was applied
-			auto sendPackageResponse = [&](bool succesfullyApplied)
-			{
-				PackageApplied applied;
-				applied.player = player;
-				applied.result = succesfullyApplied;
-				applied.packType = packType;
-				applied.requestID = requestID;
-				boost::unique_lock<boost::mutex> lock(*c.wmx);
-				c << &applied;
-			};
-			CBaseForGHApply *apply = applier->getApplier(packType); //and appropriate applier object
-			if(isBlockedByQueries(pack, player))
-			{
-				sendPackageResponse(false);
-			}
-			else if (apply)
-			{
-				const bool result = apply->applyOnGH(this, &c, pack, player);
-				if (result)
-					logGlobal->trace("Message %s successfully applied!", typeid(*pack).name());
-				else
-					complain((boost::format("Got false in applying %s... that request must have been fishy!")
-						% typeid(*pack).name()).str());
+			boost::unique_lock<boost::mutex> applyLock(simultaneousTurns.applyMx, boost::defer_lock);
+			if(simultaneousTurns.isEnabled())
+				applyLock.lock();
 
-				sendPackageResponse(true);
-			}
-			else
-			{
-				logGlobal->error("Message cannot be applied, cannot find applier (unregistered type)!");
-				sendPackageResponse(false);
-			}
+			if(!request.pack || !simultaneousTurns.postpone(request))
+				applyRequest(request);
 
-			vstd::clear_pointer(pack);
+			//applied request may have allowed other players to continue
+			while(simultaneousTurns.takeReadyRequest(request))
+				applyRequest(request);
 		}
 	}
 	catch(boost::system::system_error &e) //for boost errors just log, not crash - probably client shut down connection
@@ -1322,6 +1361,7 @@ CGameHandler::CGameHandler(void)
 	registerTypesServerPacks(*applier);
 	visitObjectAfterVictory = false;
 	queries.gh = this;
+	simultaneousTurns.gh = this;
 
 	spellEnv = new ServerSpellCastEnvironment(this);
 }
@@ -1401,6 +1441,67 @@ void CGameHandler::setPortalDwelling(const CGTownInstance * town, bool forced=fa
 		}
 }
 
+/// Values of new turn for single hero or town. They are costly to compute (bonus queries), but depend
+/// only on state of given object, so they are computed in parallel and merged into NewTurn afterwards.
+struct HeroNewTurnValues
+{
+	NewTurn::Hero hero;
+	TResources income; //estates and resource generating bonuses
+};
+
+struct TownNewTurnValues
+{
+	TResources income;
+	std::array<int, GameConstants::CREATURES_PER_TOWN> growth;
+
+	TownNewTurnValues() { growth.fill(0); }
+};
+
+static HeroNewTurnValues computeHeroNewTurn(const CGameState * gs, const CGHeroInstance * h)
+{
+	HeroNewTurnValues ret;
+	ret.hero.id = h->id;
+	auto ti = make_unique<TurnInfo>(h, 1);
+	// TODO: this code executed when bonuses of previous day not yet updated (this happen in NewTurn::applyGs). See issue 2356
+	ret.hero.move = h->maxMovePoints(gs->map->getTile(h->getPosition(false)).terType != ETerrainType::WATER, ti.get());
+	ret.hero.mana = h->getManaNewTurn();
+
+	ret.income[Res::GOLD] += h->valOfBonuses(Selector::typeSubtype(Bonus::SECONDARY_SKILL_PREMY, SecondarySkill::ESTATES)); //estates
+	for (int k = 0; k < GameConstants::RESOURCE_QUANTITY; k++)
+		ret.income[k] += h->valOfBonuses(Bonus::GENERATE_RESOURCE, k);
+	return ret;
+}
+
+static TownNewTurnValues computeTownNewTurn(const CGTownInstance * t, bool newWeek)
+{
+	TownNewTurnValues ret;
+	ret.income = t->dailyIncome();
+	if (newWeek)
+	{
+		for (int k = 0; k < GameConstants::CREATURES_PER_TOWN; k++)
+			if (!t->creatures.at(k).second.empty())
+				ret.growth[k] = t->creatureGrowth(k);
+	}
+	return ret;
+}
+
+static void runNewTurnTasks(std::vector<Task> & tasks)
+{
+	const size_t TASKS_PER_THREAD = 8; //few objects are processed faster than threads are started
+
+	ui32 threads = std::min<ui32>(boost::thread::hardware_concurrency(), tasks.size() / TASKS_PER_THREAD);
+	if (threads > 1)
+	{
+		CThreadHelper helper(&tasks, threads);
+		helper.run();
+	}
+	else
+	{
+		for (auto & task : tasks)
+			task();
+	}
+}
+
 void CGameHandler::newTurn()
 {
 	logGlobal->trace("Turn %d", gs->day+1);
@@ -1485,6 +1586,7 @@ void CGameHandler::newTurn()
 	}
 
 	std::map<ui32, ConstTransitivePtr<CGHeroInstance> > pool = gs->hpool.heroesPool;
+	std::vector<CGHeroInstance *> playerHeroes;
 
 	for (auto& hp : pool)
 	{
@@ -1546,31 +1648,52 @@ void CGameHandler::newTurn()
 		{
 			if (h->visitedTown)
 				giveSpells(h->visitedTown, h);
+			playerHeroes.push_back(h);
+		}
+	}
 
-			NewTurn::Hero hth;
-			hth.id = h->id;
-			auto ti = make_unique<TurnInfo>(h, 1);
-			// TODO: this code executed when bonuses of previous day not yet updated (this happen in NewTurn::applyGs). See issue 2356
-			hth.move = h->maxMovePoints(gs->map->getTile(h->getPosition(false)).terType != ETerrainType::WATER, ti.get());
-			hth.mana = h->getManaNewTurn();
-
-			n.heroes.insert(hth);
-
-			if (!firstTurn) //not first day
+	//game state is not changed while values are computed, no random numbers are drawn there
+	std::vector<HeroNewTurnValues> heroValues(playerHeroes.size());
+	std::vector<TownNewTurnValues> townValues(gs->map->towns.size());
+	{
+		std::vector<Task> tasks;
+		for (size_t i = 0; i < playerHeroes.size(); i++)
+		{
+			tasks.push_back([&, i]()
 			{
-				n.res[elem.first][Res::GOLD] += h->valOfBonuses(Selector::typeSubtype(Bonus::SECONDARY_SKILL_PREMY, SecondarySkill::ESTATES)); //estates
-
-				for (int k = 0; k < GameConstants::RESOURCE_QUANTITY; k++)
-				{
-					n.res[elem.first][k] += h->valOfBonuses(Bonus::GENERATE_RESOURCE, k);
-				}
-			}
+				heroValues[i] = computeHeroNewTurn(gs, playerHeroes[i]);
+			});
 		}
+		for (size_t i = 0; i < gs->map->towns.size(); i++)
+		{
+			tasks.push_back([&, i]()
+			{
+				townValues[i] = computeTownNewTurn(gs->map->towns[i], newWeek);
+			});
+		}
+		runNewTurnTasks(tasks);
+	}
+
+	for (size_t i = 0; i < playerHeroes.size(); i++)
+	{
+		n.heroes.insert(heroValues[i].hero);
+		if (!firstTurn) //not first day
+			n.res[playerHeroes[i]->tempOwner] += heroValues[i].income;
 	}
-	for (CGTownInstance *t : gs->map->towns)
+
+	//events are handled in order of towns and buildings they add may affect income and growth of other towns
+	//as well, so once any event changes buildings, values of remaining towns are computed again after their events
+	bool buildingsChanged = false;
+	for (size_t i = 0; i < gs->map->towns.size(); i++)
 	{
+		CGTownInstance *t = gs->map->towns[i];
 		PlayerColor player = t->tempOwner;
-		handleTownEvents(t, n);
+		if (handleTownEvents(t, n))
+			buildingsChanged = true;
+		if (buildingsChanged)
+			townValues[i] = computeTownNewTurn(t, newWeek);
+		const TownNewTurnValues & values = townValues[i];
+
 		if (newWeek) //first day of week
 		{
 			if (t->hasBuilt(BuildingID::PORTAL_OF_SUMMON, ETownType::DUNGEON))
@@ -1601,7 +1724,7 @@ void CGameHandler::newTurn()
 						if (firstTurn) //first day of game: use only basic growths
 							availableCount = cre->growth;
 						else
-							availableCount += t->creatureGrowth(k);
+							availableCount += values.growth[k];
 
 						//Deity of fire week - upgrade both imps and upgrades
 						if (n.specialWeek == NewTurn::DEITYOFFIRE && vstd::contains(t->creatures.at(k).second, n.creatureid))
@@ -1620,7 +1743,7 @@ void CGameHandler::newTurn()
 		}
 		if (!firstTurn  &&  player < PlayerColor::PLAYER_LIMIT)//not the first day and town not neutral
 		{
-			n.res[player] = n.res[player] + t->dailyIncome();
+			n.res[player] = n.res[player] + values.income;
 		}
 		if (t->hasBuilt(BuildingID::GRAIL, ETownType::TOWER))
 		{
@@ -1815,21 +1938,41 @@ void CGameHandler::run(bool resume)
 				}
 				else //give normal turn
 				{
-					states.setFlag(playerColor, &PlayerStatus::makingTurn, true);
+					//AI players that can't interact with this one may get their turn at the same time
+					auto group = simultaneousTurns.formGroup(it, playerTurnOrder.end());
 
-					YourTurn yt;
-					yt.player = playerColor;
-					//Change local daysWithoutCastle counter for local interface message //TODO: needed?
-					yt.daysWithoutCastle = playerState->daysWithoutCastle;
-					applyAndSend(&yt);
+					//YourTurn sets current player, so the first player of group gets it last - turn order is resumed from him
+					for (auto member = group.rbegin(); member != group.rend(); member++)
+					{
+						states.setFlag(*member, &PlayerStatus::makingTurn, true);
+
+						YourTurn yt;
+						yt.player = *member;
+						//Change local daysWithoutCastle counter for local interface message //TODO: needed?
+						yt.daysWithoutCastle = gs->players[*member].daysWithoutCastle;
+						applyAndSend(&yt);
+					}
 
 					//wait till turn is done
-					boost::unique_lock<boost::mutex> lock(states.mx);
-					while (states.players.at(playerColor).makingTurn && !end2)
+					auto isMakingTurn = [&](PlayerColor member){ return states.players.at(member).makingTurn; };
+					while (true)
 					{
-						static time_duration p = milliseconds(100);
-						states.cv.timed_wait(lock, p);
+						{
+							boost::unique_lock<boost::mutex> lock(states.mx);
+							if (!vstd::contains_if(group, isMakingTurn) || end2)
+								break;
+							static time_duration p = milliseconds(100);
+							states.cv.timed_wait(lock, p);
+						}
+						//end of battle or defeat of group member may let postponed requests continue
+						//while connection thread is blocked waiting for next request
+						if (group.size() > 1)
+							applyReadyRequests();
 					}
+					simultaneousTurns.endGroup();
+					if (group.size() > 1)
+						applyReadyRequests(); //requests left after turn end
+					std::advance(it, group.size() - 1);
 				}
 			}
 		}
@@ -1962,7 +2105,7 @@ bool CGameHandler::moveHero(ObjectInstanceID hid, int3 dst, ui8 teleporting, boo
 {
 	const CGHeroInstance *h = getHero(hid);
 	// not turn of that hero or player can't simply teleport hero (at least not with this function)
-	if (!h  || (asker != PlayerColor::NEUTRAL && (teleporting || h->getOwner() != gs->currentPlayer)))
+	if (!h  || (asker != PlayerColor::NEUTRAL && (teleporting || !isPlayerMakingTurn(h->getOwner()))))
 	{
 		logGlobal->error("Illegal call to move hero!");
 		return false;
@@ -2100,6 +2243,7 @@ bool CGameHandler::moveHero(ObjectInstanceID hid, int3 dst, ui8 teleporting, boo
 
 	if (teleporting)
 	{
+		simultaneousTurns.heroTeleported(h->tempOwner, hmpos);
 		if (blockingVisit()) // e.g. hero on the other side of teleporter
 			return true;
 
@@ -2149,7 +2293,7 @@ bool CGameHandler::teleportHero(ObjectInstanceID hid, ObjectInstanceID dstid, ui
 	const CGHeroInstance *h = getHero(hid);
 	const CGTownInstance *t = getTown(dstid);
 
-	if (!h || !t || h->getOwner() != gs->currentPlayer)
+	if (!h || !t || !isPlayerMakingTurn(h->getOwner()))
 		COMPLAIN_RET("Invalid call to teleportHero!");
 
 	const CGTownInstance *from = h->visitedTown;
@@ -2581,12 +2725,15 @@ void CGameHandler::save(const std::string & filename)
 	try
 	{
 		{
-			CSaveFile save(*CResourceHandler::get("local")->getResourceName(ResourceID(stem.to_string(), EResType::SERVER_SAVEGAME)));
+			//game state is only serialized to memory here, file is written while game continues
+			CBackgroundSaveFile save(*CResourceHandler::get("local")->getResourceName(ResourceID(stem.to_string(), EResType::SERVER_SAVEGAME)),
+				settings["general"]["compressSavegames"].Bool());
 			saveCommonState(save);
 			logGlobal->info("Saving server state");
 			save << *this;
+			save.writeInBackground();
 		}
-		logGlobal->info("Game has been successfully saved!");
+		logGlobal->info("Game has been successfully serialized, writing it in background");
 	}
 	catch(std::exception &e)
 	{
@@ -2764,7 +2911,9 @@ PlayerColor CGameHandler::getPlayerAt(CConnection *c) const
 	default:
 		{
 			//if we have more than one player at this connection, try to pick active one
-			if (vstd::contains(all, gs->currentPlayer))
+			if (requestSender.get() && vstd::contains(all, *requestSender) && simultaneousTurns.isInGroup(*requestSender))
+				return *requestSender;
+			else if (vstd::contains(all, gs->currentPlayer))
 				return gs->currentPlayer;
 			else
 				return PlayerColor::CANNOT_DETERMINE; //cannot say which player is it
@@ -4611,8 +4760,9 @@ void CGameHandler::handleTimeEvents()
 	sendAndApply(&ume);
 }
 
-void CGameHandler::handleTownEvents(CGTownInstance * town, NewTurn &n)
+bool CGameHandler::handleTownEvents(CGTownInstance * town, NewTurn &n)
 {
+	bool buildingsChanged = false;
 	town->events.sort(evntCmp);
 	while(town->events.size() && town->events.front().firstOccurence == gs->day)
 	{
@@ -4649,6 +4799,7 @@ void CGameHandler::handleTownEvents(CGTownInstance * town, NewTurn &n)
 				if (!town->hasBuilt(i))
 				{
 					buildStructure(town->id, i, true);
+					buildingsChanged = true;
 					iw.components.push_back(Component(Component::BUILDING, town->subID, i, 0));
 				}
 			}
@@ -4693,6 +4844,7 @@ void CGameHandler::handleTownEvents(CGTownInstance * town, NewTurn &n)
 	uce.town = town->id;
 	uce.events = town->events;
 	sendAndApply(&uce);
+	return buildingsChanged;
 }
 
 bool CGameHandler::complain(const std::string &problem)
@@ -5012,12 +5164,12 @@ void CGameHandler::checkVictoryLossConditionsForPlayer(PlayerColor player)
 			checkVictoryLossConditions(playerColors);
 		}
 
-		auto playerInfo = getPlayer(gs->currentPlayer, false);
-		// If we are called before the actual game start, there might be no current player
-		if (playerInfo && playerInfo->status != EPlayerStatus::INGAME)
+		// If player making turn has lost his turn must be over as well
+		// (there may be several of them when AI players make turns simultaneously)
+		for (auto & elem : gs->players)
 		{
-			// If player making turn has lost his turn must be over as well
-			states.setFlag(gs->currentPlayer, &PlayerStatus::makingTurn, false);
+			if (elem.second.status != EPlayerStatus::INGAME && isPlayerMakingTurn(elem.first))
+				states.setFlag(elem.first, &PlayerStatus::makingTurn, false);
 		}
 	}
 }
@@ -6033,6 +6185,11 @@ bool CGameHandler::isBlockedByQueries(const CPack *pack, PlayerColor player)
 	return false;
 }
 
+bool CGameHandler::isPlayerMakingTurn(PlayerColor player)
+{
+	return vstd::contains(states.players, player) && states.checkFlag(player, &PlayerStatus::makingTurn);
+}
+
 void CGameHandler::removeAfterVisit(const CGObjectInstance *object)
 {
 	//If the object is being visited, there must be a matching query
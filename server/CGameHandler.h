@@ -5,6 +5,7 @@
 #include "../lib/IGameCallback.h"
 #include "../lib/BattleAction.h"
 #include "CQuery.h"
+#include "CSimultaneousTurns.h"
 
 
 /*
@@ -91,9 +92,11 @@ public:
 	boost::recursive_mutex gsm;
 	ui32 QID;
 	Queries queries;
+	CSimultaneousTurns simultaneousTurns;
 
 	bool isValidObject(const CGObjectInstance *obj) const;
 	bool isBlockedByQueries(const CPack *pack, PlayerColor player);
+	bool isPlayerMakingTurn(PlayerColor player);
 	bool isAllowedExchange(ObjectInstanceID id1, ObjectInstanceID id2);
 	void giveSpells(const CGTownInstance *t, const CGHeroInstance *h);
 	int moveStack(int stack, BattleHex dest); //returned value - travelled distance
@@ -188,6 +191,8 @@ public:
 
 	void init(StartInfo *si);
 	void handleConnection(std::set<PlayerColor> players, CConnection &c);
+	void applyRequest(const CSimultaneousTurns::Request &request);
+	void applyReadyRequests(); //applies postponed requests that can be applied now
 	PlayerColor getPlayerAt(CConnection *c) const;
 
 	void playerMessage(PlayerColor player, const std::string &message, ObjectInstanceID currObj);
@@ -224,7 +229,7 @@ public:
 	void save(const std::string &fname);
 	void close();
 	void handleTimeEvents();
-	void handleTownEvents(CGTownInstance *town, NewTurn &n);
+	bool handleTownEvents(CGTownInstance *town, NewTurn &n); //returns true if buildings of town were changed
 	bool complain(const std::string &problem); //sends message to all clients, prints on the logs and return true
 	void objectVisited( const CGObjectInstance * obj, const CGHeroInstance * h );
 	void objectVisitEnded(const CObjectVisitQuery &query);
@@ -0,0 +1,233 @@
+#include "StdInc.h"
+#include "CSimultaneousTurns.h"
+#include "CGameHandler.h"
+#include "../lib/CConfigHandler.h"
+#include "../lib/CGameState.h"
+#include "../lib/CPathfinder.h"
+#include "../lib/CPlayerState.h"
+#include "../lib/BattleState.h"
+#include "../lib/NetPacks.h"
+#include "../lib/mapping/CMap.h"
+#include "../lib/mapObjects/CGHeroInstance.h"
+#include "../lib/serializer/CTypeList.h"
+
+/*
+ * CSimultaneousTurns.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+CSimultaneousTurns::CSimultaneousTurns() : gh(nullptr), sequential(false)
+{
+}
+
+bool CSimultaneousTurns::isEnabled() const
+{
+	return settings["server"]["simultaneousAITurns"].Bool();
+}
+
+std::vector<PlayerColor> CSimultaneousTurns::formGroup(std::list<PlayerColor>::const_iterator first, std::list<PlayerColor>::const_iterator end)
+{
+	boost::unique_lock<boost::mutex> lock(mx);
+	group.clear();
+	sequential = false;
+
+	std::vector<PlayerColor> ret;
+	ret.push_back(*first);
+
+	auto isCandidate = [&](PlayerColor player) -> bool
+	{
+		const PlayerState *state = gh->getPlayer(player, false);
+		return state && !state->human && state->status == EPlayerStatus::INGAME
+			&& vstd::contains(gh->connections, player) && gh->connections.at(player) == gh->connections.at(*first);
+	};
+	if(!isEnabled() || !isCandidate(*first))
+		return ret;
+
+	const int3 sizes = gh->getMapSize();
+	zones.resize(boost::extents[sizes.x][sizes.y][sizes.z]);
+	std::fill(zones.data(), zones.data() + zones.num_elements(), 0);
+	claimZone(*first, 1);
+
+	for(auto it = std::next(first); it != end && ret.size() < std::numeric_limits<ui8>::max(); it++)
+	{
+		if(!isCandidate(*it) || !claimZone(*it, ret.size() + 1))
+			break;
+		ret.push_back(*it);
+	}
+
+	if(ret.size() > 1)
+	{
+		group = ret;
+		logGlobal->info("%d AI players will make their turns simultaneously", group.size());
+	}
+	return ret;
+}
+
+void CSimultaneousTurns::endGroup()
+{
+	boost::unique_lock<boost::mutex> lock(mx);
+	group.clear();
+	sequential = false;
+}
+
+bool CSimultaneousTurns::isInGroup(PlayerColor player) const
+{
+	boost::unique_lock<boost::mutex> lock(mx);
+	return vstd::contains(group, player);
+}
+
+bool CSimultaneousTurns::claimZone(PlayerColor player, ui8 claim)
+{
+	CGameState *gs = gh->gameState();
+	std::vector<int3> tiles;
+
+	for(const CGObjectInstance *obj : gs->map->objects)
+	{
+		if(obj && obj->tempOwner == player)
+			tiles.push_back(obj->visitablePos());
+	}
+
+	CPathsInfo paths(gh->getMapSize());
+	for(const CGHeroInstance *hero : gs->getPlayer(player)->heroes)
+	{
+		gs->calculatePaths(hero, paths);
+		for(int x = 0; x < paths.sizes.x; x++)
+			for(int y = 0; y < paths.sizes.y; y++)
+				for(int z = 0; z < paths.sizes.z; z++)
+					for(int layer = 0; layer < EPathfindingLayer::NUM_LAYERS; layer++)
+						if(paths.nodes[x][y][z][layer].turns == 0)
+						{
+							tiles.push_back(int3(x, y, z));
+							break;
+						}
+	}
+
+	for(const int3 &tile : tiles)
+	{
+		ui8 owner = zones[tile.x][tile.y][tile.z];
+		if(owner && owner != claim)
+			return false;
+	}
+	for(const int3 &tile : tiles)
+		zones[tile.x][tile.y][tile.z] = claim;
+	return true;
+}
+
+bool CSimultaneousTurns::isInZone(PlayerColor player, const int3 &tile) const
+{
+	if(!gh->gameState()->map->isInTheMap(tile))
+		return false;
+
+	auto member = std::find(group.begin(), group.end(), player);
+	return zones[tile.x][tile.y][tile.z] == member - group.begin() + 1;
+}
+
+bool CSimultaneousTurns::isMakingTurn(PlayerColor player)
+{
+	return vstd::contains(group, player) && gh->states.checkFlag(player, &PlayerStatus::makingTurn);
+}
+
+void CSimultaneousTurns::demote(PlayerColor player, const std::string &reason)
+{
+	if(sequential)
+		return;
+
+	logGlobal->info("Player %s may interact with other players (%s), remaining players of group will act sequentially", player.getStr(), reason);
+	sequential = true;
+}
+
+void CSimultaneousTurns::checkInteraction(const Request &request)
+{
+	if(sequential || !isMakingTurn(request.player))
+		return;
+
+	if(request.packType == typeList.getTypeID<MoveHero>())
+	{
+		auto move = static_cast<const MoveHero *>(request.pack);
+		if(!isInZone(request.player, CGHeroInstance::convertPosition(move->dest, false)))
+			demote(request.player, "hero leaves zone");
+	}
+	else if(request.packType == typeList.getTypeID<CastleTeleportHero>())
+		demote(request.player, "town portal");
+	else if(request.packType == typeList.getTypeID<CastAdvSpell>())
+		demote(request.player, "adventure spell");
+}
+
+bool CSimultaneousTurns::canApply(const Request &request)
+{
+	if(!isMakingTurn(request.player))
+		return true;
+
+	//only one battle can take place at once
+	if(const BattleInfo *battle = gh->gameState()->curB)
+		return battle->sides[0].color == request.player || battle->sides[1].color == request.player;
+
+	if(!sequential)
+		return true;
+
+	//player may always answer what server asked him about
+	if(request.packType == typeList.getTypeID<QueryReply>() && gh->queries.topQuery(request.player))
+		return true;
+
+	for(PlayerColor member : group)
+	{
+		if(isMakingTurn(member))
+			return member == request.player;
+	}
+	return true;
+}
+
+bool CSimultaneousTurns::postpone(const Request &request)
+{
+	boost::unique_lock<boost::mutex> lock(mx);
+	if(postponed.empty() && group.empty())
+		return false;
+
+	bool waiting = vstd::contains_if(postponed, [&](const Request &r)
+	{
+		return r.player == request.player;
+	});
+	if(!waiting)
+	{
+		checkInteraction(request);
+		if(canApply(request))
+			return false;
+	}
+
+	logGlobal->trace("Postponing request %d of player %s", request.requestID, request.player.getStr());
+	postponed.push_back(request);
+	return true;
+}
+
+bool CSimultaneousTurns::takeReadyRequest(Request &out)
+{
+	boost::unique_lock<boost::mutex> lock(mx);
+	std::set<PlayerColor> waiting;
+	for(auto it = postponed.begin(); it != postponed.end(); it++)
+	{
+		if(vstd::contains(waiting, it->player))
+			continue;
+
+		checkInteraction(*it);
+		if(canApply(*it))
+		{
+			out = *it;
+			postponed.erase(it);
+			return true;
+		}
+		waiting.insert(it->player);
+	}
+	return false;
+}
+
+void CSimultaneousTurns::heroTeleported(PlayerColor owner, const int3 &tile)
+{
+	boost::unique_lock<boost::mutex> lock(mx);
+	if(vstd::contains(group, owner) && !isInZone(owner, tile))
+		demote(owner, "hero teleported out of zone");
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "../lib/GameConstants.h"
+#include "../lib/int3.h"
+
+/*
+ * CSimultaneousTurns.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+class CGameHandler;
+class CConnection;
+struct CPack;
+
+// Lets AI players that can't interact with each other during this turn make their turns at the same time.
+// Each player of group gets a zone: tiles his heroes can reach with movement points left and tiles of his objects.
+// Group is formed only from players with disjoint zones, so as long as every hero stays in zone of his owner
+// actions of different players are independent. Requests are still applied one by one by connection thread,
+// requests that became ready because of something else than request of the same connection (end of battle,
+// defeat of player) are applied by server main loop while it waits for group to end turn.
+// Once an action may reach outside of zone (move outside of it, teleport, adventure spell) the group is
+// demoted to sequential play - only first player still making turn may act, others wait for their turn.
+class CSimultaneousTurns
+{
+public:
+	struct Request
+	{
+		CPack *pack;
+		PlayerColor player;
+		si32 requestID;
+		int packType;
+		CConnection *connection; //that sent request and waits for response
+	};
+
+	CGameHandler *gh;
+	boost::mutex applyMx; //held while requests are postponed or applied, so requests of one player never overlap
+
+	CSimultaneousTurns();
+
+	bool isEnabled() const;
+
+	// returns players that get their turn together, starting with first - consecutive AI players from the same connection
+	std::vector<PlayerColor> formGroup(std::list<PlayerColor>::const_iterator first, std::list<PlayerColor>::const_iterator end);
+	void endGroup();
+	bool isInGroup(PlayerColor player) const;
+
+	// stores request if it can't be applied yet, requests of one player are always applied in order
+	bool postpone(const Request &request);
+	// takes first postponed request that can be applied now
+	bool takeReadyRequest(Request &out);
+
+	// hero was moved by server to given tile (eg. by monolith), demotes group if tile is outside zone of his owner
+	void heroTeleported(PlayerColor owner, const int3 &tile);
+
+private:
+	mutable boost::mutex mx;
+	std::vector<PlayerColor> group;
+	bool sequential;
+	boost::multi_array<ui8, 3> zones; //[x][y][z] - index of group member claiming tile + 1, 0 if not claimed
+	std::vector<Request> postponed;
+
+	bool claimZone(PlayerColor player, ui8 claim);
+	bool isInZone(PlayerColor player, const int3 &tile) const;
+	void checkInteraction(const Request &request);
+	bool canApply(const Request &request);
+	bool isMakingTurn(PlayerColor player);
+	void demote(PlayerColor player, const std::string &reason);
+};
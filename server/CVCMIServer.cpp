@@ -19,6 +19,8 @@
 #include "../lib/StartInfo.h"
 #include "../lib/mapping/CMap.h"
 #include "../lib/rmg/CMapGenOptions.h"
+#include "../lib/rmg/CMapPoolGenerator.h"
+#include "../lib/JsonNode.h"
 #ifndef VCMI_ANDROID
 #include "../lib/Interprocess.h"
 #endif
@@ -463,6 +465,7 @@ void CVCMIServer::loadGame()
 
 	c >> clients >> fname; //how many clients should be connected
 
+	CBackgroundSaveFile::waitForPendingWrites();
 	{
 		CLoadFile lf(*CResourceHandler::get("local")->getResourceName(ResourceID(fname, EResType::SERVER_SAVEGAME)), MINIMAL_SERIALIZATION_VERSION);
 		gh.loadCommonState(lf);
@@ -498,7 +501,10 @@ static void handleCommandOptions(int argc, char *argv[])
 		("help,h", "display help and exit")
 		("version,v", "display version information and exit")
 		("port", po::value<int>()->default_value(3030), "port at which server will listen to connections from client")
-		("resultsFile", po::value<std::string>()->default_value("./results.txt"), "file to which the battle result will be appended. Used only in the DUEL mode.");
+		("resultsFile", po::value<std::string>()->default_value("./results.txt"), "file to which the battle result will be appended. Used only in the DUEL mode.")
+		("generateMaps", po::value<std::string>(), "generate random maps listed in given json file and exit")
+		("mapPoolDir", po::value<std::string>(), "directory for maps generated with --generateMaps, defaults to Maps/Pool in user data directory")
+		("threads", po::value<int>()->default_value(0), "number of maps generated in parallel, 0 for number of cores");
 
 	if(argc > 1)
 	{
@@ -534,6 +540,33 @@ static void handleCommandOptions(int argc, char *argv[])
 	}
 }
 
+static int generateMapPool()
+{
+	boost::filesystem::path jobsFile(cmdLineOptions["generateMaps"].as<std::string>());
+	boost::filesystem::path outputDir = VCMIDirs::get().userDataPath() / "Maps" / "Pool";
+	if(cmdLineOptions.count("mapPoolDir"))
+		outputDir = cmdLineOptions["mapPoolDir"].as<std::string>();
+
+	boost::filesystem::ifstream file(jobsFile, boost::filesystem::ifstream::binary);
+	if(!file)
+	{
+		logGlobal->errorStream() << "Can not open " << jobsFile.string();
+		return EXIT_FAILURE;
+	}
+	std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	JsonNode config(data.c_str(), data.size());
+
+	auto jobs = CMapPoolGenerator::parseJobs(config);
+	logGlobal->infoStream() << "Generating " << jobs.size() << " maps into " << outputDir.string();
+
+	CMapPoolGenerator generator(outputDir);
+	auto results = generator.generate(jobs, cmdLineOptions["threads"].as<int>());
+
+	int failed = boost::count_if(results, [](const CMapGenJobResult & result){ return !result.success; });
+	logGlobal->infoStream() << "Generated " << results.size() - failed << " maps, " << failed << " failed";
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
 #if defined(__GNUC__) && !defined (__MINGW32__) && !defined(VCMI_ANDROID)
 void handleLinuxSignal(int sig)
 {
@@ -584,6 +617,16 @@ int main(int argc, char** argv)
 	logConfig.configure();
 
 	loadDLLClasses();
+
+	if(cmdLineOptions.count("generateMaps"))
+	{
+		int ret = generateMapPool();
+		delete VLC;
+		VLC = nullptr;
+		CResourceHandler::clear();
+		return ret;
+	}
+
 	srand ( (ui32)time(nullptr) );
 	try
 	{
@@ -615,6 +658,7 @@ int main(int argc, char** argv)
 		//and return non-zero status so client can detect error
 		throw;
 	}
+	CBackgroundSaveFile::waitForPendingWrites();
 	delete VLC;
 	VLC = nullptr;
 	CResourceHandler::clear();
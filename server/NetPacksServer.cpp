@@ -66,12 +66,14 @@ bool CloseServer::applyGh( CGameHandler *gh )
 
 bool EndTurn::applyGh( CGameHandler *gh )
 {
-	PlayerColor player = GS(gh)->currentPlayer;
+	//several AI players may be making turn at once, so player is taken from request
 	ERROR_IF_NOT(player);
+	if(!gh->isPlayerMakingTurn(player))
+		COMPLAIN_AND_RETURN("Cannot end turn of player that is not making turn!");
 	if(gh->queries.topQuery(player))
 		COMPLAIN_AND_RETURN("Cannot end turn before resolving queries!");
 
-	gh->states.setFlag(GS(gh)->currentPlayer,&PlayerStatus::makingTurn,false);
+	gh->states.setFlag(player,&PlayerStatus::makingTurn,false);
 	return true;
 }
 
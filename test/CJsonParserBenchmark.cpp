@@ -0,0 +1,99 @@
+/*
+ * CJsonParserBenchmark.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../lib/JsonNode.h"
+
+#ifdef VCMI_WINDOWS
+	#include <windows.h>
+	#include <psapi.h>
+#else
+	#include <sys/resource.h>
+#endif
+
+/// Parses all json files from given directories (config/ by default) several times and prints
+/// time per pass and peak resident memory. Files are read into memory before timing starts.
+/// Trees of the last pass are kept alive, so peak memory includes one complete set of parsed trees.
+
+static const int BENCHMARK_PASSES = 20;
+
+static double peakMemoryMB()
+{
+#ifdef VCMI_WINDOWS
+	PROCESS_MEMORY_COUNTERS counters;
+	GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+	return counters.PeakWorkingSetSize / 1048576.0;
+#else
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#ifdef VCMI_APPLE
+	return usage.ru_maxrss / 1048576.0; //in bytes
+#else
+	return usage.ru_maxrss / 1024.0; //in kilobytes
+#endif
+#endif
+}
+
+static void readFiles(const boost::filesystem::path & dir, std::vector<std::string> & files)
+{
+	for(boost::filesystem::recursive_directory_iterator it(dir), end; it != end; ++it)
+	{
+		if(!boost::filesystem::is_regular_file(it->status()) || !boost::iequals(it->path().extension().string(), ".json"))
+			continue;
+
+		boost::filesystem::ifstream file(it->path(), std::ios::binary);
+		files.push_back(std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+	}
+}
+
+int main(int argc, char * argv[])
+{
+	std::vector<std::string> files;
+	if(argc > 1)
+	{
+		for(int i = 1; i < argc; i++)
+			readFiles(argv[i], files);
+	}
+	else
+		readFiles("config", files);
+
+	size_t totalSize = 0;
+	for(auto & file : files)
+		totalSize += file.size();
+
+	std::cout << boost::format("%d files, %.1f MB, peak memory before parsing: %.1f MB") % files.size() % (totalSize / 1048576.0) % peakMemoryMB() << std::endl;
+	if(files.empty())
+		return 1;
+
+	std::vector<JsonNode> trees;
+	double best = std::numeric_limits<double>::max();
+	double total = 0;
+
+	for(int pass = 0; pass < BENCHMARK_PASSES; pass++)
+	{
+		trees.clear();
+		trees.reserve(files.size());
+
+		auto start = boost::posix_time::microsec_clock::universal_time();
+		for(auto & file : files)
+			trees.push_back(JsonNode(file.data(), file.size()));
+		auto end = boost::posix_time::microsec_clock::universal_time();
+
+		double time = (end - start).total_microseconds() / 1000.0;
+		vstd::amin(best, time);
+		total += time;
+	}
+
+	std::cout << boost::format("%d passes: %.1f ms per pass, best %.1f ms, %.1f MB/s") % BENCHMARK_PASSES
+		% (total / BENCHMARK_PASSES) % best % (totalSize / 1048576.0 / (best / 1000.0)) << std::endl;
+	std::cout << boost::format("Peak memory with parsed trees: %.1f MB") % peakMemoryMB() << std::endl;
+	return 0;
+}
@@ -0,0 +1,118 @@
+/*
+ * CMapGeneratorBenchmark.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "CVcmiTestConfig.h"
+
+#include "../lib/VCMI_Lib.h"
+#include "../lib/mapping/CMap.h"
+#include "../lib/rmg/CMapGenOptions.h"
+#include "../lib/rmg/CMapGenerator.h"
+#include "../lib/rmg/CRmgTemplate.h"
+#include "../lib/rmg/CRmgTemplateStorage.h"
+
+/// Generates random maps for fixed set of map sizes and seeds and prints time spent on every map.
+/// Names of templates to use can be passed as arguments, otherwise generator picks template from the seed.
+/// With "--repeat N" every map is generated N times and the best time is reported, which makes runs comparable.
+
+static const int BENCHMARK_SEEDS[] = { 1337, 4242, 31337 };
+
+static const int BENCHMARK_SIZES[] =
+{
+	CMapHeader::MAP_SIZE_SMALL,
+	CMapHeader::MAP_SIZE_MIDDLE,
+	CMapHeader::MAP_SIZE_LARGE,
+	CMapHeader::MAP_SIZE_XLARGE
+};
+
+static double generateMap(int size, int seed, const CRmgTemplate * tpl, std::string & usedTemplate)
+{
+	CMapGenOptions opt;
+
+	opt.setHeight(size);
+	opt.setWidth(size);
+	opt.setHasTwoLevels(true);
+	opt.setPlayerCount(4);
+	opt.setPlayerTypeForStandardPlayer(PlayerColor(0), EPlayerType::HUMAN);
+	opt.setMapTemplate(tpl);
+
+	if(!opt.checkOptions())
+		return -1;
+
+	auto start = boost::posix_time::microsec_clock::universal_time();
+
+	CMapGenerator gen;
+	auto map = gen.generate(&opt, seed);
+
+	auto end = boost::posix_time::microsec_clock::universal_time();
+
+	usedTemplate = opt.getMapTemplate()->getName();
+	return (end - start).total_microseconds() / 1000.0;
+}
+
+int main(int argc, char * argv[])
+{
+	CVcmiTestConfig config;
+
+	std::vector<const CRmgTemplate *> templates;
+	int repeats = 1;
+	for(int i = 1; i < argc; i++)
+	{
+		if(std::string(argv[i]) == "--repeat" && i + 1 < argc)
+		{
+			repeats = std::max(1, std::atoi(argv[++i]));
+			continue;
+		}
+
+		bool found = false;
+		for(const auto & tpl : VLC->tplh->getTemplates())
+		{
+			if(tpl.second->getName() == argv[i])
+			{
+				templates.push_back(tpl.second);
+				found = true;
+			}
+		}
+		if(!found)
+			std::cerr << "Unknown template: " << argv[i] << std::endl;
+	}
+	if(templates.empty())
+		templates.push_back(nullptr);
+
+	for(int size : BENCHMARK_SIZES)
+	{
+		double total = 0;
+		int maps = 0;
+
+		for(const CRmgTemplate * tpl : templates)
+		{
+			for(int seed : BENCHMARK_SEEDS)
+			{
+				std::string usedTemplate;
+				double time = generateMap(size, seed, tpl, usedTemplate);
+				for(int i = 1; i < repeats && time >= 0; i++)
+					vstd::amin(time, generateMap(size, seed, tpl, usedTemplate));
+
+				if(time < 0)
+				{
+					std::cout << boost::format("%dx%d, seed %d: no suitable template") % size % size % seed << std::endl;
+					continue;
+				}
+				std::cout << boost::format("%dx%d, seed %d, template %s: %.0f ms") % size % size % seed % usedTemplate % time << std::endl;
+				total += time;
+				maps++;
+			}
+		}
+
+		if(maps)
+			std::cout << boost::format("%dx%d: %.0f ms per map") % size % size % (total / maps) << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * CSaveFileTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include "../lib/serializer/BinarySerializer.h"
+#include "../lib/serializer/BinaryDeserializer.h"
+
+struct CSaveFileFixture
+{
+	boost::filesystem::path file;
+	std::string text;
+	std::vector<std::vector<si32>> payload;
+
+	CSaveFileFixture()
+		: file(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("vcmi-savetest-%%%%%%%%.vsgm1")),
+		text("VCMI save test")
+	{
+		// several compressed chunks of data that can't be compressed to nothing
+		// split into parts to stay below length considered suspicious by deserializer
+		const size_t partLength = COMPRESSED_CHUNK_SIZE / sizeof(si32) / 2;
+		ui32 value = 1337;
+		payload.resize(7);
+		for(auto & part : payload)
+		{
+			for(size_t i = 0; i < partLength; i++)
+			{
+				value = value * 1103515245 + 12345;
+				part.push_back(value >> 16);
+			}
+		}
+	}
+
+	~CSaveFileFixture()
+	{
+		boost::system::error_code ec;
+		boost::filesystem::remove(file, ec);
+	}
+
+	void save(bool compress)
+	{
+		CBackgroundSaveFile saveFile(file, compress);
+		saveFile << text;
+		saveFile.finishChunk();
+		saveFile << payload << text;
+		saveFile.writeInBackground();
+		CBackgroundSaveFile::waitForPendingWrites();
+	}
+
+	void checkLoad()
+	{
+		std::string loadedText, loadedTail;
+		std::vector<std::vector<si32>> loadedPayload;
+
+		CLoadFile loadFile(file);
+		loadFile >> loadedText >> loadedPayload >> loadedTail;
+
+		BOOST_CHECK_EQUAL(text, loadedText);
+		BOOST_CHECK_EQUAL(text, loadedTail);
+		BOOST_REQUIRE_EQUAL(payload.size(), loadedPayload.size());
+		BOOST_CHECK(payload == loadedPayload);
+	}
+};
+
+BOOST_FIXTURE_TEST_CASE(CSaveFile_RoundTrip, CSaveFileFixture)
+{
+	save(false);
+	checkLoad();
+}
+
+BOOST_FIXTURE_TEST_CASE(CSaveFile_CompressedRoundTrip, CSaveFileFixture)
+{
+	save(true);
+	BOOST_CHECK_LT(boost::filesystem::file_size(file), payload.size() * payload[0].size() * sizeof(si32));
+	checkLoad();
+}
+
+BOOST_FIXTURE_TEST_CASE(CSaveFile_CorruptedChunkHeader, CSaveFileFixture)
+{
+	{
+		boost::filesystem::ofstream out(file, std::ios::binary);
+		out.write(COMPRESSED_FILE_MAGIC.c_str(), COMPRESSED_FILE_MAGIC.length());
+		out.write(reinterpret_cast<const char *>(&SERIALIZATION_VERSION), sizeof(SERIALIZATION_VERSION));
+		const ui32 header[2] = {0xFFFFFFFF, 16}; //decompressed size way over chunk size
+		out.write(reinterpret_cast<const char *>(header), sizeof(header));
+		out.write(std::string(16, 'x').c_str(), 16);
+	}
+
+	//must be rejected before anything is allocated or decompressed
+	auto isHeaderError = [](const std::runtime_error & e)
+	{
+		return boost::algorithm::contains(e.what(), "invalid chunk header");
+	};
+
+	std::string loadedText;
+	CLoadFile loadFile(file);
+	BOOST_CHECK_EXCEPTION(loadFile >> loadedText, std::runtime_error, isHeaderError);
+}
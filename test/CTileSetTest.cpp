@@ -0,0 +1,144 @@
+/*
+ * CTileSetTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include <boost/test/unit_test.hpp>
+
+#include "../lib/rmg/CTileSet.h"
+#include "../lib/int3.h"
+
+static void checkSameAsStdSet(const CTileSet & tiles, const std::set<int3> & expected)
+{
+	BOOST_CHECK_EQUAL(tiles.size(), expected.size());
+	BOOST_CHECK_EQUAL(tiles.empty(), expected.empty());
+	BOOST_REQUIRE_EQUAL(std::distance(tiles.begin(), tiles.end()), expected.size());
+	BOOST_CHECK(std::equal(tiles.begin(), tiles.end(), expected.begin()));
+
+	//iterating backwards gives the same tiles in reverse order
+	std::vector<int3> reversed;
+	for(auto it = tiles.end(); it != tiles.begin();)
+		reversed.push_back(*--it);
+	BOOST_CHECK(std::equal(reversed.begin(), reversed.end(), expected.rbegin()));
+}
+
+BOOST_AUTO_TEST_CASE(CTileSet_Empty)
+{
+	CTileSet tiles;
+	BOOST_CHECK(tiles.empty());
+	BOOST_CHECK_EQUAL(tiles.size(), 0);
+	BOOST_CHECK(tiles.begin() == tiles.end());
+	BOOST_CHECK(!tiles.contains(int3(0, 0, 0)));
+	BOOST_CHECK_EQUAL(tiles.erase(int3(0, 0, 0)), 0);
+
+	//set that had tiles and lost them again is empty as well
+	tiles.insert(int3(3, 4, 0));
+	tiles.erase(int3(3, 4, 0));
+	BOOST_CHECK(tiles.empty());
+	BOOST_CHECK(tiles.begin() == tiles.end());
+
+	tiles.insert(int3(3, 4, 0));
+	tiles.clear();
+	BOOST_CHECK(tiles.empty());
+	BOOST_CHECK(tiles.begin() == tiles.end());
+	BOOST_CHECK(!tiles.contains(int3(3, 4, 0)));
+}
+
+BOOST_AUTO_TEST_CASE(CTileSet_InsertEraseContains)
+{
+	CTileSet tiles;
+	BOOST_CHECK(tiles.insert(int3(5, 7, 0)));
+	BOOST_CHECK(!tiles.insert(int3(5, 7, 0)));
+	BOOST_CHECK(tiles.insert(int3(6, 7, 0)));
+	BOOST_CHECK_EQUAL(tiles.size(), 2);
+
+	BOOST_CHECK(tiles.contains(int3(5, 7, 0)));
+	BOOST_CHECK(tiles.contains(int3(6, 7, 0)));
+	BOOST_CHECK(!tiles.contains(int3(7, 5, 0)));
+	BOOST_CHECK(!tiles.contains(int3(5, 7, 1)));
+	BOOST_CHECK(!tiles.contains(int3(100, 100, 100)));
+
+	BOOST_CHECK_EQUAL(tiles.erase(int3(5, 7, 0)), 1);
+	BOOST_CHECK_EQUAL(tiles.erase(int3(5, 7, 0)), 0);
+	BOOST_CHECK_EQUAL(tiles.erase(int3(100, 100, 100)), 0);
+	BOOST_CHECK(!tiles.contains(int3(5, 7, 0)));
+	BOOST_CHECK(tiles.contains(int3(6, 7, 0)));
+	BOOST_CHECK_EQUAL(tiles.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(CTileSet_IterationOrder)
+{
+	//same order as std::set<int3>: by z, then y, then x
+	const int3 input[] = { int3(2, 1, 1), int3(0, 0, 1), int3(3, 0, 0), int3(1, 2, 0), int3(0, 2, 0), int3(2, 0, 0), int3(63, 0, 0), int3(64, 0, 0) };
+
+	CTileSet tiles;
+	std::set<int3> expected;
+	for(auto & tile : input)
+	{
+		tiles.insert(tile);
+		expected.insert(tile);
+	}
+	checkSameAsStdSet(tiles, expected);
+
+	BOOST_CHECK_EQUAL(*tiles.begin(), int3(2, 0, 0));
+	BOOST_CHECK_EQUAL(*std::prev(tiles.end()), int3(2, 1, 1));
+
+	//erasing does not invalidate iterators
+	auto it = tiles.begin();
+	++it;
+	BOOST_CHECK_EQUAL(*it, int3(3, 0, 0));
+	tiles.erase(int3(3, 0, 0));
+	expected.erase(int3(3, 0, 0));
+	++it;
+	BOOST_CHECK_EQUAL(*it, int3(63, 0, 0));
+	checkSameAsStdSet(tiles, expected);
+}
+
+BOOST_AUTO_TEST_CASE(CTileSet_Grow)
+{
+	CTileSet tiles;
+	std::set<int3> expected;
+	auto insert = [&](const int3 & tile)
+	{
+		tiles.insert(tile);
+		expected.insert(tile);
+	};
+
+	insert(int3(1, 1, 0));
+	insert(int3(2, 1, 0));
+
+	//past initial bounds in every direction, tiles inserted before must survive
+	insert(int3(40, 1, 0));
+	insert(int3(1, 30, 0));
+	insert(int3(5, 5, 1));
+	checkSameAsStdSet(tiles, expected);
+
+	//negative offsets move origin of the bitmap
+	insert(int3(-1, 1, 0));
+	insert(int3(-70, 2, 0));
+	insert(int3(3, -5, 0));
+	insert(int3(0, 0, -1));
+	checkSameAsStdSet(tiles, expected);
+
+	BOOST_CHECK(tiles.contains(int3(-70, 2, 0)));
+	BOOST_CHECK(!tiles.contains(int3(-70, 1, 0)));
+	BOOST_CHECK(!tiles.contains(int3(-1000, 0, 0)));
+	BOOST_CHECK_EQUAL(tiles.erase(int3(-1000, 0, 0)), 0);
+	BOOST_CHECK_EQUAL(tiles.erase(int3(3, -5, 0)), 1);
+	expected.erase(int3(3, -5, 0));
+	checkSameAsStdSet(tiles, expected);
+
+	//many tiles spanning several words
+	for(int y = -10; y < 10; y++)
+		for(int x = -20; x < 50; x += 3)
+			insert(int3(x, y, 0));
+	checkSameAsStdSet(tiles, expected);
+	for(auto & tile : expected)
+		BOOST_CHECK(tiles.contains(tile));
+}